@@ -0,0 +1,284 @@
+// bench/bench.cpp
+// -------------------------------------------------------------
+// Microbenchmarks for the per-request hot paths (make bench).
+//
+// Every case runs a fixed number of iterations, repeated
+// kRepeats times; the median and minimum ns/op go to stdout as
+// JSON with a fixed key order, so two runs diff cleanly:
+//
+//   make -s bench > bench.json
+//   ./bench_runner htmlEscape        (only cases containing the text)
+//
+// Page rows are rendered from canned result sets; nothing here
+// opens a database connection.
+// -------------------------------------------------------------
+#include "core/ActivityQuery.hpp"
+#include "pages/BrowsePage.hpp"
+#include "pages/TransactionsPage.hpp"
+#include "utils/FormData.hpp"
+#include "utils/JsonWriter.hpp"
+#include "utils/Money.hpp"
+#include "utils/PasswordHash.hpp"
+#include "utils/utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr int kRepeats = 7;
+
+// Keeps results observable so the optimizer cannot drop the work
+volatile std::size_t gSink = 0;
+
+struct Case {
+    std::string name;
+    long iterations;
+    std::function<void()> body;
+};
+
+struct Result {
+    std::string name;
+    long iterations;
+    long long medianNs;
+    long long minNs;
+};
+
+// Discards everything written to std::cout while a case runs
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+Result runCase(const Case& c) {
+    // Warm up caches and lazy statics
+    for (long i = 0; i < c.iterations / 10 + 1; ++i) c.body();
+
+    std::vector<long long> perOp;
+    for (int r = 0; r < kRepeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < c.iterations; ++i) c.body();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        perOp.push_back(ns / c.iterations);
+    }
+    std::sort(perOp.begin(), perOp.end());
+    return { c.name, c.iterations, perOp[perOp.size() / 2], perOp.front() };
+}
+
+// -------------------------------------------------------------
+// Canned inputs
+// -------------------------------------------------------------
+const std::string kPlainText = "Vintage mechanical keyboard with original keycaps";
+const std::string kMarkupText = "<b>\"Rare\"</b> Tom & Jerry's 1950s lunchbox <script>alert(1)</script>";
+const std::string kEncoded = "email=jane.doe%40example.com&password=p%40ss+w%C3%B6rd%21&remember=on";
+const std::string kCookies = "theme=dark; _ga=GA1.2.123456789.987654321; session_token=9f86d081884c7d659a2feaa0c55ad015; lang=en";
+const std::string kPostBody = "item_id=12345&bid_amount=1049.99&view=item";
+const std::string kSellBody =
+    "title=Vintage+mechanical+keyboard&description=" + std::string(1500, 'x') +
+    "&start_price=25.00&start_date=2025-11-01T10%3A00&duration=7";
+
+struct BrowseRow {
+    long id;
+    std::string title;
+    std::string email;
+    long sellerId;
+    Money price;
+    long long end;
+};
+
+std::vector<BrowseRow> cannedBrowseRows() {
+    std::vector<BrowseRow> rows;
+    for (long i = 0; i < 100; ++i) {
+        rows.push_back({ 1000 + i,
+            (i % 7 == 0 ? kMarkupText : kPlainText).substr(0, 20 + i % 40),
+            "seller" + std::to_string(i % 13) + "@example.com",
+            i % 13 + 1, Money::fromCents(1999 + i * 137), 1761000000 + i * 3600 });
+    }
+    return rows;
+}
+
+std::vector<ActivityQuery::Row> cannedActivityRows() {
+    static const std::string leader = "winner@example.com";
+    std::vector<ActivityQuery::Row> rows;
+    for (long i = 0; i < 25; ++i) {
+        ActivityQuery::Row r{};
+        r.section = "bids";
+        r.itemId = 2000 + i;
+        r.title = (i % 5 == 0) ? std::string_view(kMarkupText) : std::string_view(kPlainText);
+        r.endEpoch = 1761000000 + i * 600;
+        r.hasWinner = (i % 3 != 0);
+        r.winnerId = 42;
+        r.leader = r.hasWinner ? std::string_view(leader) : std::string_view();
+        r.topBid = Money::fromCents(5000 + i * 25);
+        r.myMax = Money::fromCents(4900 + i * 25);
+        rows.push_back(r);
+    }
+    return rows;
+}
+
+std::vector<Case> buildCases() {
+    static const std::vector<BrowseRow> browseRows = cannedBrowseRows();
+    static const std::vector<ActivityQuery::Row> activityRows = cannedActivityRows();
+    static const std::string storedHash = hashPassword("correct horse battery staple", 1000);
+
+    std::vector<Case> cases;
+
+    // --- escaping / decoding ---------------------------------
+    cases.push_back({ "htmlEscape/plain", 200000, [] {
+        gSink = gSink + htmlEscape(kPlainText).size();
+    } });
+    cases.push_back({ "htmlEscape/markup", 200000, [] {
+        gSink = gSink + htmlEscape(kMarkupText).size();
+    } });
+    cases.push_back({ "appendHtmlEscaped/markup", 200000, [] {
+        char buf[512];
+        std::pmr::monotonic_buffer_resource mr(buf, sizeof(buf));
+        std::pmr::string out(&mr);
+        appendHtmlEscaped(out, kMarkupText);
+        gSink = gSink + out.size();
+    } });
+    cases.push_back({ "urlDecode/form", 200000, [] {
+        gSink = gSink + urlDecode(kEncoded).size();
+    } });
+    cases.push_back({ "FormData/parse", 200000, [] {
+        char buf[1024];
+        std::pmr::monotonic_buffer_resource mr(buf, sizeof(buf));
+        FormData form(&mr);
+        form.parse(kEncoded);
+        gSink = gSink + form["password"].size();
+    } });
+    cases.push_back({ "getCookieValue/session", 200000, [] {
+        gSink = gSink + getCookieValue(kCookies, "session_token").size();
+    } });
+
+    // --- POST bodies from stdin -------------------------------
+    // CONTENT_LENGTH is reset inside each body since the cases
+    // share the environment
+    cases.push_back({ "parsePostData/bid", 100000, [] {
+        std::istringstream in(kPostBody);
+        std::streambuf* old = std::cin.rdbuf(in.rdbuf());
+        setenv("CONTENT_LENGTH", std::to_string(kPostBody.size()).c_str(), 1);
+        FormData form;
+        parsePostData(form, 8 * 1024);
+        std::cin.rdbuf(old);
+        gSink = gSink + form["bid_amount"].size();
+    } });
+    cases.push_back({ "parsePostData/sell", 50000, [] {
+        std::istringstream in(kSellBody);
+        std::streambuf* old = std::cin.rdbuf(in.rdbuf());
+        setenv("CONTENT_LENGTH", std::to_string(kSellBody.size()).c_str(), 1);
+        FormData form;
+        parsePostData(form, 16 * 1024);
+        std::cin.rdbuf(old);
+        gSink = gSink + form["description"].size();
+    } });
+
+    // --- security ---------------------------------------------
+    // Fixed low cost so the number tracks the code, not the
+    // calibrated production iteration count
+    cases.push_back({ "hashPassword/pbkdf2-1000", 200, [] {
+        gSink = gSink + hashPassword("correct horse battery staple", 1000).size();
+    } });
+    cases.push_back({ "verifyPassword/pbkdf2-1000", 200, [] {
+        gSink = gSink + static_cast<std::size_t>(
+            verifyPassword("correct horse battery staple", storedHash, 1000));
+    } });
+    cases.push_back({ "generateSessionToken", 20000, [] {
+        gSink = gSink + generateSessionToken().size();
+    } });
+
+    // --- money (formatCurrency's replacement) ----------------
+    cases.push_back({ "Money/format", 1000000, [] {
+        char buf[Money::kMaxChars];
+        gSink = gSink + static_cast<std::size_t>(Money::fromCents(123456789).format(buf) - buf);
+    } });
+    cases.push_back({ "Money/parse", 1000000, [] {
+        Money m;
+        gSink = gSink + static_cast<std::size_t>(Money::parse("1049.99", m));
+    } });
+
+    // --- page rows from canned result sets --------------------
+    cases.push_back({ "BrowsePage/renderRow x100", 2000, [] {
+        for (const BrowseRow& r : browseRows)
+            BrowsePage::renderRow(r.id, r.title, r.email, r.sellerId, r.price, r.end, 7);
+    } });
+    for (const ActivityQuery::Section* s : ActivityQuery::kSections) {
+        cases.push_back({ std::string("TransactionsPage/renderRow x25 ") + s->id, 5000, [s] {
+            char buf[32 * 1024];
+            std::pmr::monotonic_buffer_resource mr(buf, sizeof(buf));
+            std::pmr::string out(&mr);
+            for (const ActivityQuery::Row& r : activityRows)
+                TransactionsPage::renderRow(out, *s, r, 1761000000 + 7200);
+            gSink = gSink + out.size();
+        } });
+    }
+
+    // --- JSON API serialization -------------------------------
+    cases.push_back({ "JsonWriter/item x100", 2000, [] {
+        JsonWriter w(std::cout);
+        w.beginObject().key("items").beginArray();
+        for (const BrowseRow& r : browseRows) {
+            w.beginObject()
+                .key("id").number(r.id)
+                .key("title").string(r.title)
+                .key("seller").string(r.email)
+                .key("price").money(r.price)
+                .key("end").number(r.end)
+                .endObject();
+        }
+        w.endArray().endObject();
+    } });
+
+    return cases;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    std::vector<Case> cases = buildCases();
+
+    // Rendering cases write to std::cout; results are printed
+    // through the real buffer afterwards
+    NullBuffer null;
+    std::streambuf* real = std::cout.rdbuf();
+
+    std::vector<Result> results;
+    for (const Case& c : cases) {
+        if (!filter.empty() && c.name.find(filter) == std::string_view::npos)
+            continue;
+        std::cout.rdbuf(&null);
+        Result r = runCase(c);
+        std::cout.rdbuf(real);
+        std::cerr << r.name << ": " << r.medianNs << " ns/op\n";
+        results.push_back(r);
+    }
+
+    JsonWriter json(std::cout);
+    json.beginObject()
+        .key("schema").number(1)
+        .key("repeats").number(kRepeats)
+        .key("benchmarks").beginArray();
+    for (const Result& r : results) {
+        json.beginObject()
+            .key("name").string(r.name)
+            .key("iterations").number(r.iterations)
+            .key("ns_per_op").number(r.medianNs)
+            .key("ns_per_op_min").number(r.minNs)
+            .endObject();
+    }
+    json.endArray().endObject();
+    std::cout << "\n";
+    return 0;
+}
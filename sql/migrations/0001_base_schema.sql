@@ -0,0 +1,50 @@
+-- =============================================================
+-- Base schema — Team Elevate Auctions
+-- The four tables the pages were written against. Existing
+-- deployments already have them, so every statement is a no-op
+-- there; on a fresh database this creates them with primary
+-- keys only (the query indexes come in 0004).
+--
+-- Money is DECIMAL(10, 2); times are DATETIME in the server's
+-- time zone.
+-- =============================================================
+
+CREATE TABLE IF NOT EXISTS users (
+    user_id       INT UNSIGNED NOT NULL AUTO_INCREMENT,
+    user_email    VARCHAR(255) NOT NULL,
+    password_hash VARCHAR(255) NOT NULL,
+    joindate      DATETIME NOT NULL,
+    PRIMARY KEY (user_id),
+    UNIQUE KEY uk_users_email (user_email)
+) ENGINE=InnoDB;
+
+CREATE TABLE IF NOT EXISTS items (
+    item_id        INT UNSIGNED NOT NULL AUTO_INCREMENT,
+    seller_id      INT UNSIGNED NOT NULL,
+    title          VARCHAR(100) NOT NULL,
+    description    TEXT NOT NULL,
+    start_price    DECIMAL(10, 2) NOT NULL,
+    start_time     DATETIME NOT NULL,
+    end_time       DATETIME NOT NULL,
+    winning_bid_id INT UNSIGNED NULL,
+    winner_id      INT UNSIGNED NULL,
+    PRIMARY KEY (item_id)
+) ENGINE=InnoDB;
+
+CREATE TABLE IF NOT EXISTS bids (
+    bid_id     INT UNSIGNED NOT NULL AUTO_INCREMENT,
+    item_id    INT UNSIGNED NOT NULL,
+    bidder_id  INT UNSIGNED NOT NULL,
+    bid_amount DECIMAL(10, 2) NOT NULL,
+    bid_time   DATETIME NOT NULL,
+    PRIMARY KEY (bid_id)
+) ENGINE=InnoDB;
+
+CREATE TABLE IF NOT EXISTS sessions (
+    session_id    INT UNSIGNED NOT NULL AUTO_INCREMENT,
+    user_id       INT UNSIGNED NOT NULL,
+    session_token VARCHAR(64) NOT NULL,
+    ip_address    VARCHAR(45) NOT NULL,
+    last_active   DATETIME NOT NULL,
+    PRIMARY KEY (session_id)
+) ENGINE=InnoDB;
@@ -0,0 +1,13 @@
+-- =============================================================
+-- users.password_hash — Team Elevate Auctions
+-- Widen the column for salted KDF hashes:
+--
+--   pbkdf2-sha256$<iterations>$<32 hex salt>$<64 hex hash>
+--
+-- Legacy 64-character unsalted SHA-256 digests stay valid and
+-- are rewritten in the new format on each user's next login
+-- (LoginPage), so no bulk rehash is needed.
+-- =============================================================
+
+ALTER TABLE users
+    MODIFY password_hash VARCHAR(255) NOT NULL;
@@ -0,0 +1,40 @@
+-- =============================================================
+-- user_item_activity — Team Elevate Auctions
+-- One row per (user, item) a user sells or has bid on, so
+-- My Transactions renders from a single indexed range scan
+-- instead of per-row MAX()/EXISTS subqueries over bids.
+--
+--   role     'seller' for the listing owner, 'bidder' otherwise
+--   max_bid  the user's highest bid on the item (NULL for sellers)
+--   end_time copied from items so the scan is ordered by the index
+--
+-- Maintained by SellPage (seller row on listing) and
+-- BidPlacement (bidder row upserted on every accepted bid, for
+-- bid.cgi and the JSON API alike). Open/closed and
+-- won/lost are derived at read time from end_time and
+-- items.winner_id, so auction close needs no extra write.
+-- =============================================================
+
+CREATE TABLE IF NOT EXISTS user_item_activity (
+    user_id  INT UNSIGNED NOT NULL,
+    item_id  INT UNSIGNED NOT NULL,
+    role     ENUM('seller', 'bidder') NOT NULL,
+    max_bid  DECIMAL(10, 2) NULL,
+    end_time DATETIME NOT NULL,
+    PRIMARY KEY (user_id, item_id),
+    KEY idx_uia_user_end (user_id, end_time, item_id)
+) ENGINE=InnoDB;
+
+-- -------------------------------------------------------------
+-- Backfill from existing listings and bids (safe to re-run)
+-- -------------------------------------------------------------
+INSERT IGNORE INTO user_item_activity (user_id, item_id, role, max_bid, end_time)
+SELECT i.seller_id, i.item_id, 'seller', NULL, i.end_time
+FROM items i;
+
+INSERT INTO user_item_activity (user_id, item_id, role, max_bid, end_time)
+SELECT b.bidder_id, b.item_id, 'bidder', MAX(b.bid_amount), i.end_time
+FROM bids b
+JOIN items i ON i.item_id = b.item_id
+GROUP BY b.bidder_id, b.item_id, i.end_time
+ON DUPLICATE KEY UPDATE max_bid = GREATEST(IFNULL(max_bid, 0), VALUES(max_bid));
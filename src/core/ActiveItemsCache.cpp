@@ -0,0 +1,266 @@
+// core/ActiveItemsCache.cpp
+#include "core/ActiveItemsCache.hpp"
+#include "core/ConcurrencyLimiter.hpp"
+#include "core/SharedSegment.hpp"
+#include "core/Statement.hpp"
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sched.h>
+
+const char* const ActiveItemsCache::kSnapshotSql =
+    "SELECT i.item_id, i.seller_id, i.title, u.user_email, "
+    "       CAST(ROUND(COALESCE(wb.bid_amount, i.start_price)*100) AS SIGNED), "
+    "       UNIX_TIMESTAMP(i.start_time), UNIX_TIMESTAMP(i.end_time) "
+    "FROM items i "
+    "JOIN users u ON u.user_id = i.seller_id "
+    "LEFT JOIN bids wb ON wb.bid_id = i.winning_bid_id "
+    "WHERE i.end_time > FROM_UNIXTIME(?) "
+    "ORDER BY i.end_time ASC, i.title ASC";
+
+namespace {
+
+constexpr std::uint32_t kMaxItems = 16384;
+constexpr std::uint32_t kTextBytes = 2u * 1024 * 1024;
+constexpr int kReadAttempts = 8;
+constexpr std::int64_t kOversizedSeconds = 60;   // recheck interval once the catalog outgrew the segment
+
+struct Entry {
+    std::uint32_t itemId;
+    std::uint32_t sellerId;
+    std::int64_t currentCents;
+    std::int64_t startEpoch;
+    std::int64_t endEpoch;
+    std::uint32_t titleOff, titleLen;
+    std::uint32_t emailOff, emailLen;
+};
+
+// Everything after `seq` is guarded by it, except `gen`, which
+// invalidate() bumps atomically at any time, and `oversizedUntil`,
+// which a refresh that did not fit sets atomically.
+struct Layout {
+    std::uint64_t seq;        // odd while a refresh is being written
+    std::uint64_t gen;        // invalidation generation
+    std::int64_t oversizedUntil;   // epoch before which load() does not try
+    std::uint64_t builtGen;   // `gen` observed before the refresh query
+    std::int64_t builtAt;     // epoch of the refresh
+    std::uint32_t count;
+    std::uint32_t textBytes;
+    Entry entries[kMaxItems];
+    char text[kTextBytes];
+};
+
+// Snapshot copied out of shared memory into request storage
+struct Copy {
+    std::pmr::vector<Entry> entries;
+    std::pmr::string text;
+    std::uint64_t builtGen = 0;
+    std::int64_t builtAt = 0;
+
+    explicit Copy(std::pmr::memory_resource* mr) : entries(mr), text(mr) {}
+};
+
+enum class Refresh { Built, Failed, Oversized };
+
+const char* kSegmentName = "active-items-v2";
+
+unsigned ttlSeconds() {
+    const char* v = std::getenv("AUCTION_ITEMS_CACHE_TTL_S");
+    unsigned out = 5;
+    if (v && *v) {
+        const char* end = v + std::strlen(v);
+        auto [ptr, ec] = std::from_chars(v, end, out);
+        if (ec != std::errc() || ptr != end) out = 5;
+    }
+    return out;
+}
+
+// -------------------------------------------------------------
+// Seqlock read: copy, then confirm no refresh overlapped
+// -------------------------------------------------------------
+bool readSnapshot(Layout* shm, Copy& out) {
+    std::atomic_ref<std::uint64_t> seq(shm->seq);
+
+    for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+        const std::uint64_t before = seq.load(std::memory_order_acquire);
+        if (before == 0) return false;            // never built
+        if (before & 1) { sched_yield(); continue; }
+
+        // Clamp: a torn header must not send the copy out of bounds
+        std::uint32_t count = shm->count;
+        std::uint32_t textBytes = shm->textBytes;
+        if (count > kMaxItems) count = kMaxItems;
+        if (textBytes > kTextBytes) textBytes = kTextBytes;
+
+        out.entries.assign(shm->entries, shm->entries + count);
+        out.text.assign(shm->text, textBytes);
+        out.builtGen = shm->builtGen;
+        out.builtAt = shm->builtAt;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == before)
+            return true;
+    }
+    return false;
+}
+
+void writeSnapshot(Layout* shm, const Copy& snap) {
+    std::atomic_ref<std::uint64_t> seq(shm->seq);
+    // Round an odd value up: a writer that died mid-refresh must
+    // not leave the next one publishing under an odd sequence
+    std::uint64_t s = seq.load(std::memory_order_relaxed);
+    s += (s & 1);
+
+    seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(shm->entries, snap.entries.data(), snap.entries.size() * sizeof(Entry));
+    std::memcpy(shm->text, snap.text.data(), snap.text.size());
+    shm->count = static_cast<std::uint32_t>(snap.entries.size());
+    shm->textBytes = static_cast<std::uint32_t>(snap.text.size());
+    shm->builtGen = snap.builtGen;
+    shm->builtAt = snap.builtAt;
+
+    seq.store(s + 2, std::memory_order_release);
+}
+
+// -------------------------------------------------------------
+// Rebuild from MariaDB. Reads the primary: a snapshot built from
+// a lagging replica would be served to everyone, including the
+// bidder whose invalidate() triggered the rebuild.
+// -------------------------------------------------------------
+Refresh querySnapshot(Database& db, std::time_t now, Copy& out) {
+    const char* sql = ActiveItemsCache::kSnapshotSql;
+
+    long long nowEpoch = static_cast<long long>(now);
+    MYSQL_BIND p[1]; std::memset(p, 0, sizeof(p));
+    p[0].buffer_type = MYSQL_TYPE_LONGLONG; p[0].buffer = &nowEpoch;
+
+    long id = 0, seller = 0;
+    char titleBuf[256]; unsigned long titleLen = 0;
+    char emailBuf[129]; unsigned long emailLen = 0;
+    long long cents = 0, startEpoch = 0, endEpoch = 0;
+
+    MYSQL_BIND r[7]; std::memset(r, 0, sizeof(r));
+    r[0].buffer_type = MYSQL_TYPE_LONG;     r[0].buffer = &id;     r[0].is_unsigned = 1;
+    r[1].buffer_type = MYSQL_TYPE_LONG;     r[1].buffer = &seller; r[1].is_unsigned = 1;
+    r[2].buffer_type = MYSQL_TYPE_STRING;   r[2].buffer = titleBuf; r[2].buffer_length = sizeof(titleBuf); r[2].length = &titleLen;
+    r[3].buffer_type = MYSQL_TYPE_STRING;   r[3].buffer = emailBuf; r[3].buffer_length = sizeof(emailBuf); r[3].length = &emailLen;
+    r[4].buffer_type = MYSQL_TYPE_LONGLONG; r[4].buffer = &cents;
+    r[5].buffer_type = MYSQL_TYPE_LONGLONG; r[5].buffer = &startEpoch;
+    r[6].buffer_type = MYSQL_TYPE_LONGLONG; r[6].buffer = &endEpoch;
+
+    Statement stmt(db, sql);
+    if (!stmt.bindParams(p) || !stmt.execute(Statement::Fetch::Streaming) || !stmt.bindResult(r))
+        return Refresh::Failed;
+
+    bool fits = true;
+    while (stmt.fetch()) {
+        if (!fits) continue;   // drain so the connection stays usable
+        const std::uint32_t tLen = static_cast<std::uint32_t>(titleLen < sizeof(titleBuf) ? titleLen : sizeof(titleBuf));
+        const std::uint32_t eLen = static_cast<std::uint32_t>(emailLen < sizeof(emailBuf) ? emailLen : sizeof(emailBuf));
+        if (out.entries.size() >= kMaxItems || out.text.size() + tLen + eLen > kTextBytes) {
+            fits = false;
+            continue;
+        }
+
+        Entry e{};
+        e.itemId = static_cast<std::uint32_t>(id);
+        e.sellerId = static_cast<std::uint32_t>(seller);
+        e.currentCents = cents;
+        e.startEpoch = startEpoch;
+        e.endEpoch = endEpoch;
+        e.titleOff = static_cast<std::uint32_t>(out.text.size());
+        e.titleLen = tLen;
+        out.text.append(titleBuf, tLen);
+        e.emailOff = static_cast<std::uint32_t>(out.text.size());
+        e.emailLen = eLen;
+        out.text.append(emailBuf, eLen);
+        out.entries.push_back(e);
+    }
+    out.builtAt = now;
+    if (stmt.failed()) return Refresh::Failed;
+    return fits ? Refresh::Built : Refresh::Oversized;
+}
+
+void toItems(const Copy& snap, std::time_t now, std::pmr::vector<ActiveItemsCache::Item>& out) {
+    out.clear();
+    out.reserve(snap.entries.size());
+    for (const Entry& e : snap.entries) {
+        if (e.endEpoch <= now) continue;
+        if (static_cast<std::size_t>(e.titleOff) + e.titleLen > snap.text.size() ||
+            static_cast<std::size_t>(e.emailOff) + e.emailLen > snap.text.size())
+            continue;
+        out.push_back(ActiveItemsCache::Item{
+            static_cast<long>(e.itemId),
+            static_cast<long>(e.sellerId),
+            Money::fromCents(e.currentCents),
+            static_cast<std::time_t>(e.startEpoch),
+            static_cast<std::time_t>(e.endEpoch),
+            std::string_view(snap.text).substr(e.titleOff, e.titleLen),
+            std::string_view(snap.text).substr(e.emailOff, e.emailLen) });
+    }
+}
+
+} // namespace
+
+// -------------------------------------------------------------
+// Serve fresh snapshot, else refresh (one winner), else stale
+// -------------------------------------------------------------
+bool ActiveItemsCache::load(Database& db, std::time_t now,
+    std::pmr::memory_resource* mr, std::pmr::vector<Item>& out) {
+    SharedSegment segment(kSegmentName, sizeof(Layout));
+    Layout* shm = segment.as<Layout>();
+    if (!shm) return false;
+
+    // The catalog outgrew the segment recently: go straight to the
+    // direct query rather than scanning it again just to find out
+    std::atomic_ref<std::int64_t> oversizedUntil(shm->oversizedUntil);
+    if (now < oversizedUntil.load(std::memory_order_relaxed))
+        return false;
+
+    // Allocated from `mr` so the string_views in `out` outlive this call
+    Copy* snap = new (mr->allocate(sizeof(Copy), alignof(Copy))) Copy(mr);
+
+    const bool have = readSnapshot(shm, *snap);
+    const std::uint64_t gen = std::atomic_ref<std::uint64_t>(shm->gen).load(std::memory_order_acquire);
+    if (have && snap->builtGen == gen && now - snap->builtAt < static_cast<std::int64_t>(ttlSeconds())) {
+        toItems(*snap, now, out);
+        return true;
+    }
+
+    ConcurrencyLimiter refresh("active-items-refresh", 1);
+    if (refresh.acquire(0)) {
+        Copy* fresh = new (mr->allocate(sizeof(Copy), alignof(Copy))) Copy(mr);
+        fresh->builtGen = gen;
+        switch (querySnapshot(db, now, *fresh)) {
+        case Refresh::Built:
+            writeSnapshot(shm, *fresh);
+            toItems(*fresh, now, out);
+            return true;
+        case Refresh::Oversized:
+            // The old snapshot would silently miss items
+            oversizedUntil.store(now + kOversizedSeconds, std::memory_order_relaxed);
+            return false;
+        case Refresh::Failed:
+            break;   // fall back to the previous snapshot, if any
+        }
+    }
+
+    // Someone else is refreshing, or the refresh failed: the
+    // previous snapshot will do
+    if (have) {
+        toItems(*snap, now, out);
+        return true;
+    }
+    return false;
+}
+
+void ActiveItemsCache::invalidate() {
+    SharedSegment segment(kSegmentName, sizeof(Layout));
+    if (Layout* shm = segment.as<Layout>())
+        std::atomic_ref<std::uint64_t>(shm->gen).fetch_add(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,60 @@
+// core/ActiveItemsCache.hpp
+#pragma once
+
+#include <ctime>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+#include "core/Database.hpp"
+#include "utils/Money.hpp"
+
+// =============================================================
+// ActiveItemsCache — Team Elevate Auctions
+// Versioned snapshot of every unexpired item (id, title, seller,
+// current price, start/end time), kept in a SharedSegment so
+// the thousands of short-lived bid.cgi / browse.cgi processes
+// stop rebuilding the same list from MariaDB.
+//
+//  - Readers copy the snapshot out under a seqlock: no locks,
+//    and a copy torn by a concurrent refresh is simply retried.
+//  - A snapshot is fresh while it is younger than
+//    AUCTION_ITEMS_CACHE_TTL_S (default 5 s) and no write has
+//    called invalidate() since it was built.
+//  - A stale snapshot is rebuilt by whichever process wins a
+//    non-blocking flock; the others keep serving the previous
+//    snapshot meanwhile (or query directly if there is none).
+//    A failed refresh also keeps serving the previous snapshot.
+//  - A catalog too large for the segment is remembered for a
+//    minute, during which load() declines straight away.
+//
+// Prices shown from the snapshot are therefore at most one
+// refresh behind; BidPage still validates every bid against a
+// direct lookup.
+// =============================================================
+class ActiveItemsCache {
+public:
+    struct Item {
+        long id;
+        long sellerId;
+        Money current;            // winning bid, else start price
+        std::time_t startEpoch;
+        std::time_t endEpoch;
+        std::string_view title;        // point into `mr` storage
+        std::string_view sellerEmail;
+    };
+
+    // Fill `out` with items whose end time is after `now`, ordered
+    // by end time then title. False when no snapshot could be
+    // served (segment unavailable, catalog too large for it, or
+    // the refresh failed with no previous snapshot); callers then
+    // query directly. `mr` should be the request arena: the copy
+    // is never freed individually.
+    static bool load(Database& db, std::time_t now,
+        std::pmr::memory_resource* mr, std::pmr::vector<Item>& out);
+
+    // Mark the current snapshot stale (after a bid or a new listing).
+    static void invalidate();
+
+    // The snapshot refresh query (checked by make plan-test)
+    static const char* const kSnapshotSql;
+};
@@ -0,0 +1,64 @@
+// core/ActivityQuery.cpp
+#include "core/ActivityQuery.hpp"
+#include <charconv>
+
+const ActivityQuery::Section* ActivityQuery::findSection(std::string_view id) {
+    for (const Section* s : kSections)
+        if (id == s->id) return s;
+    return nullptr;
+}
+
+bool ActivityQuery::parseCursor(std::string_view text, Cursor& out) {
+    std::size_t dot = text.find('.');
+    if (dot == std::string_view::npos) return false;
+    const char* end = text.data() + text.size();
+    auto a = std::from_chars(text.data(), text.data() + dot, out.endEpoch);
+    auto b = std::from_chars(text.data() + dot + 1, end, out.itemId);
+    return a.ec == std::errc() && a.ptr == text.data() + dot &&
+           b.ec == std::errc() && b.ptr == end;
+}
+
+std::string ActivityQuery::formatCursor(const Cursor& c) {
+    char buf[48];
+    char* p = std::to_chars(buf, buf + 24, c.endEpoch).ptr;
+    *p++ = '.';
+    p = std::to_chars(p, buf + sizeof(buf), c.itemId).ptr;
+    return std::string(buf, p);
+}
+
+// -------------------------------------------------------------
+// SELECT for one section, newest (or soonest-ending) first
+// -------------------------------------------------------------
+void ActivityQuery::appendSection(std::pmr::string& sql, Params& params, const Section& s,
+    long userId, std::time_t now, const Cursor* after, int limit) {
+    const char* dir = s.ascending ? "ASC" : "DESC";
+    const char* cmp = s.ascending ? ">" : "<";
+
+    sql += "(SELECT '";
+    sql += s.id;
+    sql += "' AS section, i.item_id, i.title, UNIX_TIMESTAMP(a.end_time) AS end_epoch, "
+           "i.winner_id, IFNULL(w.user_email, '') AS leader, "
+           "CAST(ROUND(IFNULL(wb.bid_amount, 0)*100) AS SIGNED) AS top_cents, "
+           "CAST(ROUND(IFNULL(a.max_bid, 0)*100) AS SIGNED) AS my_cents "
+           "FROM user_item_activity a "
+           "JOIN items i ON i.item_id = a.item_id "
+           "LEFT JOIN users w ON w.user_id = i.winner_id "
+           "LEFT JOIN bids wb ON wb.bid_id = i.winning_bid_id "
+           "WHERE a.user_id = ? AND ";
+    sql += s.where;
+    params.add(userId);
+    if (s.usesNow) params.add(static_cast<long long>(now));
+
+    if (after) {
+        sql += " AND (a.end_time "; sql += cmp; sql += " FROM_UNIXTIME(?) OR "
+               "(a.end_time = FROM_UNIXTIME(?) AND a.item_id "; sql += cmp; sql += " ?))";
+        params.add(after->endEpoch);
+        params.add(after->endEpoch);
+        params.add(after->itemId);
+    }
+
+    sql += " ORDER BY a.end_time "; sql += dir;
+    sql += ", a.item_id "; sql += dir;
+    sql += " LIMIT ?)";
+    params.add(limit);
+}
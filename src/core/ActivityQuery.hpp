@@ -0,0 +1,137 @@
+// core/ActivityQuery.hpp
+#pragma once
+
+#include <cstring>
+#include <ctime>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <mysql/mysql.h>
+#include "core/Database.hpp"
+#include "core/Statement.hpp"
+#include "utils/Money.hpp"
+
+// =============================================================
+// ActivityQuery — Team Elevate Auctions
+// One user's auction activity as keyset-paginated sections over
+// user_item_activity(user_id, end_time, item_id). Shared by
+// TransactionsPage (HTML) and ApiPage (/api/me/transactions).
+// =============================================================
+class ActivityQuery {
+public:
+    struct Section {
+        const char* id;         // tab / tbody / ?section= name
+        const char* where;      // extra predicate after a.user_id = ?
+        bool usesNow;           // `where` binds the request time once
+        bool ascending;         // sort (and cursor) direction on end_time
+        int columns;            // for the empty-state row
+        const char* emptyText;
+    };
+
+    static constexpr Section kSelling   { "selling",   "a.role = 'seller'", false, false, 5, "No listings." };
+    static constexpr Section kPurchases { "purchases", "a.role = 'bidder' AND a.end_time <= FROM_UNIXTIME(?) AND i.winner_id = a.user_id", true, false, 3, "No purchases yet." };
+    static constexpr Section kBids      { "bids",      "a.role = 'bidder' AND a.end_time > FROM_UNIXTIME(?)", true, true, 6, "No active bids." };
+    static constexpr Section kLost      { "lost",      "a.role = 'bidder' AND a.end_time <= FROM_UNIXTIME(?) AND i.winner_id <> a.user_id", true, false, 3, "No lost auctions." };
+
+    static constexpr const Section* kSections[] = { &kSelling, &kPurchases, &kBids, &kLost };
+
+    static const Section* findSection(std::string_view id);
+
+    // ---------------------------------------------------------
+    // Keyset cursor "<end_epoch>.<item_id>" of the last row shown
+    // ---------------------------------------------------------
+    struct Cursor {
+        long long endEpoch = 0;
+        long long itemId = 0;
+    };
+
+    static bool parseCursor(std::string_view text, Cursor& out);
+    static std::string formatCursor(const Cursor& c);
+
+    // ---------------------------------------------------------
+    // Fixed-capacity parameter list (4 sections x 6 binds at most),
+    // so bind buffers never move once their address is taken
+    // ---------------------------------------------------------
+    struct Params {
+        long long values[24];
+        MYSQL_BIND binds[24];
+        unsigned int count = 0;
+
+        Params() { std::memset(binds, 0, sizeof(binds)); }
+
+        void add(long long v) {
+            values[count] = v;
+            binds[count].buffer_type = MYSQL_TYPE_LONGLONG;
+            binds[count].buffer = &values[count];
+            ++count;
+        }
+    };
+
+    // One parenthesized SELECT ... LIMIT for a section; UNION ALL of
+    // all four gives a first page of everything in one round trip.
+    static void appendSection(std::pmr::string& sql, Params& params, const Section& s,
+        long userId, std::time_t now, const Cursor* after, int limit);
+
+    // ---------------------------------------------------------
+    // One row of the activity scan (views valid during the callback)
+    // ---------------------------------------------------------
+    struct Row {
+        std::string_view section;
+        long itemId;
+        std::string_view title;
+        long long endEpoch;
+        bool hasWinner;
+        long winnerId;
+        std::string_view leader;    // current leader / winner email
+        Money topBid;               // items.winning_bid_id amount
+        Money myMax;                // user's highest bid on the item
+    };
+
+    // Rows are at most one page + 1 per section, so they stream
+    // straight from the server without a client-side result copy.
+    // Served by a replica when one is usable (Database::Route).
+    template <typename OnRow>
+    static bool scan(Database& db, std::string_view sql, Params& params, OnRow&& onRow);
+};
+
+template <typename OnRow>
+bool ActivityQuery::scan(Database& db, std::string_view sql, Params& params, OnRow&& onRow) {
+    Statement stmt(db, sql, Database::Route::Replica);
+    if (!stmt.bindParams(params.binds)) return false;
+
+    char sectionBuf[16]; unsigned long sectionLen = 0;
+    long itemId = 0;
+    char titleBuf[256]; unsigned long titleLen = 0;
+    long long endEpoch = 0;
+    long winnerId = 0; my_bool winnerNull = 0;
+    char leaderBuf[129]; unsigned long leaderLen = 0;
+    long long topCents = 0, myCents = 0;
+
+    MYSQL_BIND r[8]; std::memset(r, 0, sizeof(r));
+    r[0].buffer_type = MYSQL_TYPE_STRING;   r[0].buffer = sectionBuf; r[0].buffer_length = sizeof(sectionBuf); r[0].length = &sectionLen;
+    r[1].buffer_type = MYSQL_TYPE_LONG;     r[1].buffer = &itemId;    r[1].is_unsigned = 1;
+    r[2].buffer_type = MYSQL_TYPE_STRING;   r[2].buffer = titleBuf;   r[2].buffer_length = sizeof(titleBuf);   r[2].length = &titleLen;
+    r[3].buffer_type = MYSQL_TYPE_LONGLONG; r[3].buffer = &endEpoch;
+    r[4].buffer_type = MYSQL_TYPE_LONG;     r[4].buffer = &winnerId;  r[4].is_unsigned = 1; r[4].is_null = &winnerNull;
+    r[5].buffer_type = MYSQL_TYPE_STRING;   r[5].buffer = leaderBuf;  r[5].buffer_length = sizeof(leaderBuf);  r[5].length = &leaderLen;
+    r[6].buffer_type = MYSQL_TYPE_LONGLONG; r[6].buffer = &topCents;
+    r[7].buffer_type = MYSQL_TYPE_LONGLONG; r[7].buffer = &myCents;
+
+    if (!stmt.execute(Statement::Fetch::Streaming) || !stmt.bindResult(r)) return false;
+
+    auto clip = [](unsigned long len, std::size_t cap) { return len < cap ? len : cap; };
+    while (stmt.fetch()) {
+        Row row;
+        row.section = std::string_view(sectionBuf, clip(sectionLen, sizeof(sectionBuf)));
+        row.itemId = itemId;
+        row.title = std::string_view(titleBuf, clip(titleLen, sizeof(titleBuf)));
+        row.endEpoch = endEpoch;
+        row.hasWinner = !winnerNull;
+        row.winnerId = winnerId;
+        row.leader = std::string_view(leaderBuf, clip(leaderLen, sizeof(leaderBuf)));
+        row.topBid = Money::fromCents(topCents);
+        row.myMax = Money::fromCents(myCents);
+        onRow(row);
+    }
+    return !stmt.failed();
+}
@@ -0,0 +1,80 @@
+// core/BidEvents.cpp
+#include "core/BidEvents.hpp"
+#include "core/SharedSegment.hpp"
+#include <atomic>
+
+namespace {
+
+struct Slot {
+    std::uint64_t seq;        // 0 or stale while being written
+    std::int64_t itemId;
+    std::int64_t priceCents;
+    std::int64_t endEpoch;
+    std::int64_t leaderId;
+};
+
+struct Layout {
+    std::uint64_t head;       // last seq handed out
+    Slot slots[BidEvents::kSlots];
+};
+
+const char* kSegmentName = "bid-events-v1";
+
+} // namespace
+
+// -------------------------------------------------------------
+// Claim the next seq, fill its slot, then stamp the slot's seq
+// -------------------------------------------------------------
+void BidEvents::publish(long itemId, Money price, std::time_t endEpoch, long leaderId) {
+    SharedSegment segment(kSegmentName, sizeof(Layout));
+    Layout* shm = segment.as<Layout>();
+    if (!shm) return;
+
+    const std::uint64_t seq =
+        std::atomic_ref<std::uint64_t>(shm->head).fetch_add(1, std::memory_order_acq_rel) + 1;
+    Slot& s = shm->slots[seq % kSlots];
+    std::atomic_ref<std::uint64_t> slotSeq(s.seq);
+
+    slotSeq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.itemId = itemId;
+    s.priceCents = price.cents();
+    s.endEpoch = static_cast<std::int64_t>(endEpoch);
+    s.leaderId = leaderId;
+    slotSeq.store(seq, std::memory_order_release);
+}
+
+std::uint64_t BidEvents::head() {
+    SharedSegment segment(kSegmentName, sizeof(Layout));
+    Layout* shm = segment.as<Layout>();
+    return shm ? std::atomic_ref<std::uint64_t>(shm->head).load(std::memory_order_acquire) : 0;
+}
+
+// -------------------------------------------------------------
+// Per-slot seqlock read
+// -------------------------------------------------------------
+BidEvents::Read BidEvents::read(std::uint64_t seq, Event& out) {
+    SharedSegment segment(kSegmentName, sizeof(Layout));
+    Layout* shm = segment.as<Layout>();
+    if (!shm) return Read::Unavailable;
+
+    const std::uint64_t head = std::atomic_ref<std::uint64_t>(shm->head).load(std::memory_order_acquire);
+    if (seq > head) return Read::NotYet;
+    if (head - seq >= kSlots) return Read::Lost;
+
+    Slot& s = shm->slots[seq % kSlots];
+    std::atomic_ref<std::uint64_t> slotSeq(s.seq);
+
+    const std::uint64_t before = slotSeq.load(std::memory_order_acquire);
+    if (before > seq) return Read::Lost;
+    if (before != seq) return Read::NotYet;   // claimed, still being written
+
+    const Slot copy{ seq, s.itemId, s.priceCents, s.endEpoch, s.leaderId };
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slotSeq.load(std::memory_order_relaxed) != seq)
+        return Read::Lost;
+
+    out = Event{ seq, static_cast<long>(copy.itemId), Money::fromCents(copy.priceCents),
+                 static_cast<std::time_t>(copy.endEpoch), static_cast<long>(copy.leaderId) };
+    return Read::Ok;
+}
@@ -0,0 +1,48 @@
+// core/BidEvents.hpp
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include "utils/Money.hpp"
+
+// =============================================================
+// BidEvents — Team Elevate Auctions
+// Host-wide fan-out of accepted bids. Every CGI runs in its own
+// process, so there is no in-process hub to subscribe to: the
+// bid path appends to a ring of kSlots events in a SharedSegment
+// and each events.cgi stream tails that ring.
+//
+//  - Event ids (seq) start at 1 and increase by one per publish;
+//    they double as SSE ids so a reconnecting client resumes
+//    from Last-Event-ID.
+//  - Each slot carries its own sequence number, written last,
+//    so a reader can tell a finished slot from one being written
+//    or one already overwritten by a later lap.
+//
+// publish() never blocks and never fails the bid; when the
+// segment is unavailable, events are simply not delivered.
+// =============================================================
+class BidEvents {
+public:
+    static constexpr std::uint32_t kSlots = 4096;
+
+    struct Event {
+        std::uint64_t seq;
+        long itemId;
+        Money price;          // new leading bid
+        std::time_t endEpoch;
+        long leaderId;        // bidder now winning
+    };
+
+    static void publish(long itemId, Money price, std::time_t endEpoch, long leaderId);
+
+    // Id of the most recent event (0 = none yet / unavailable)
+    static std::uint64_t head();
+
+    enum class Read { Ok, NotYet, Lost, Unavailable };
+
+    // Copy event `seq` into `out`: NotYet while it has not been
+    // (fully) published, Lost once a later lap overwrote it,
+    // Unavailable when the segment cannot be mapped.
+    static Read read(std::uint64_t seq, Event& out);
+};
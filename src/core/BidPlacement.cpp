@@ -0,0 +1,186 @@
+// core/BidPlacement.cpp
+#include "core/BidPlacement.hpp"
+#include "core/ActiveItemsCache.hpp"
+#include "core/BidEvents.hpp"
+#include "core/Metrics.hpp"
+#include "core/Statement.hpp"
+#include "core/WriteAdmission.hpp"
+#include <cstring>
+
+const char* const BidPlacement::kTopBidSql =
+    "SELECT bid_id, bidder_id, CAST(ROUND(bid_amount*100) AS SIGNED) "
+    "FROM bids "
+    "WHERE item_id = ? "
+    "ORDER BY bid_amount DESC, bid_time ASC "
+    "LIMIT 1";
+
+// Metrics counter for each outcome (spelled out, so reordering
+// either enum cannot count under the wrong label)
+static Metrics::Counter counterFor(BidPlacement::Outcome outcome) {
+    using O = BidPlacement::Outcome;
+    switch (outcome) {
+    case O::Placed:      return Metrics::BidPlaced;
+    case O::NotLoggedIn: return Metrics::BidNotLoggedIn;
+    case O::Throttled:   return Metrics::BidThrottled;
+    case O::NoSuchItem:  return Metrics::BidNoSuchItem;
+    case O::OwnItem:     return Metrics::BidOwnItem;
+    case O::NotActive:   return Metrics::BidNotActive;
+    case O::TooLow:      return Metrics::BidTooLow;
+    case O::Failed:      return Metrics::BidFailed;
+    }
+    return Metrics::BidFailed;
+}
+
+BidPlacement::Result BidPlacement::place(RequestContext& ctx, long itemId, Money amount) {
+    Result r = attempt(ctx, itemId, amount);
+    Metrics::add(counterFor(r.outcome));
+    return r;
+}
+
+BidPlacement::Result BidPlacement::attempt(RequestContext& ctx, long itemId, Money amount) {
+    if (!ctx.loggedIn())
+        return { Outcome::NotLoggedIn };
+
+    Database& db = ctx.db();
+    long userId = ctx.userId();
+
+    // Admission control before any write-path statements; the slot
+    // is held until the write path below has finished.
+    static constexpr WriteAdmission::Defaults kBidLimits{
+        { 20, 5 },        // per user: 20/min, bursts of 5
+        { 3000, 200 },    // all bidders
+        8,                // concurrent bid writes
+        100 };            // ms to wait for a slot
+    WriteAdmission admission("bid", userId, kBidLimits);
+    if (!admission.admitted()) {
+        Result r{ Outcome::Throttled };
+        r.retryAfter = admission.retryAfter();
+        return r;
+    }
+
+    // Load item state
+    const RequestContext::ItemState* item = ctx.itemState(itemId);
+    if (!item)
+        return { Outcome::NoSuchItem };
+
+    // Business rules
+    if (item->sellerId == userId)
+        return { Outcome::OwnItem };
+    if (!item->active)
+        return { Outcome::NotActive };
+
+    Money floor = (item->currentMaxBid > item->startPrice ? item->currentMaxBid : item->startPrice);
+    if (amount <= floor)
+        return { Outcome::TooLow, floor };
+
+    const std::time_t endEpoch = item->endEpoch;
+
+    // Insert bid
+    const char* sql =
+        "INSERT INTO bids (item_id, bidder_id, bid_amount, bid_time) "
+        "VALUES (?, ?, ? / 100, NOW())";
+
+    long long amountCents = amount.cents();
+    MYSQL_BIND bp[3]; std::memset(bp, 0, sizeof(bp));
+    bp[0].buffer_type = MYSQL_TYPE_LONG;     bp[0].buffer = &itemId; bp[0].is_unsigned = 1;
+    bp[1].buffer_type = MYSQL_TYPE_LONG;     bp[1].buffer = &userId; bp[1].is_unsigned = 1;
+    bp[2].buffer_type = MYSQL_TYPE_LONGLONG; bp[2].buffer = &amountCents;
+
+    {
+        Statement stmt(db, sql);
+        if (!stmt.ok()) {
+            Result r{ Outcome::Failed, floor };
+            r.error = "Internal error";
+            return r;
+        }
+        if (!stmt.bindParams(bp) || !stmt.execute()) {
+            Result r{ Outcome::Failed, floor };
+            r.error = stmt.error();
+            return r;
+        }
+    }
+
+    //
+    // Update for items table
+    //
+    // 1) Find current top bid for this item
+    const char* sqlTop = kTopBidSql;
+
+    MYSQL_BIND topParam[1];
+    std::memset(topParam, 0, sizeof(topParam));
+    topParam[0].buffer_type = MYSQL_TYPE_LONG;
+    topParam[0].buffer = &itemId;
+    topParam[0].is_unsigned = 1;
+
+    long topBidId = 0;
+    long topBidderId = 0;
+    long long topCents = 0;
+
+    MYSQL_BIND topRes[3];
+    std::memset(topRes, 0, sizeof(topRes));
+    topRes[0].buffer_type = MYSQL_TYPE_LONG;
+    topRes[0].buffer = &topBidId;
+    topRes[0].is_unsigned = 1;
+    topRes[1].buffer_type = MYSQL_TYPE_LONG;
+    topRes[1].buffer = &topBidderId;
+    topRes[1].is_unsigned = 1;
+    topRes[2].buffer_type = MYSQL_TYPE_LONGLONG;
+    topRes[2].buffer = &topCents;
+
+    bool haveTop = false;
+    {
+        Statement topStmt(db, sqlTop);
+        haveTop = topStmt.bindParams(topParam) && topStmt.execute() &&
+                  topStmt.bindResult(topRes) && topStmt.fetch() &&
+                  topBidId > 0 && topBidderId > 0;
+    }
+
+    // 2) Update items with current leading bid + bidder
+    if (haveTop) {
+        const char* sqlUpdate =
+            "UPDATE items "
+            "SET winning_bid_id = ?, winner_id = ? "
+            "WHERE item_id = ?";
+
+        MYSQL_BIND upParam[3];
+        std::memset(upParam, 0, sizeof(upParam));
+
+        upParam[0].buffer_type = MYSQL_TYPE_LONG;
+        upParam[0].buffer = &topBidId;
+        upParam[0].is_unsigned = 1;
+
+        upParam[1].buffer_type = MYSQL_TYPE_LONG;
+        upParam[1].buffer = &topBidderId;
+        upParam[1].is_unsigned = 1;
+
+        upParam[2].buffer_type = MYSQL_TYPE_LONG;
+        upParam[2].buffer = &itemId;
+        upParam[2].is_unsigned = 1;
+
+        db.execute(sqlUpdate, upParam, 3);
+    }
+
+    // Current prices in the shared listing snapshot are now stale;
+    // open event streams get the new price right away. That is the
+    // top bid, which a concurrent higher bid may have made not ours.
+    ActiveItemsCache::invalidate();
+    if (haveTop)
+        BidEvents::publish(itemId, Money::fromCents(topCents), endEpoch, topBidderId);
+    else
+        BidEvents::publish(itemId, amount, endEpoch, userId);
+
+    // 3) Record the bidder's running max for My Transactions
+    const char* sqlActivity =
+        "INSERT INTO user_item_activity (user_id, item_id, role, max_bid, end_time) "
+        "SELECT ?, i.item_id, 'bidder', ? / 100, i.end_time FROM items i WHERE i.item_id = ? "
+        "ON DUPLICATE KEY UPDATE max_bid = GREATEST(IFNULL(max_bid, 0), VALUES(max_bid))";
+    MYSQL_BIND ap[3]; std::memset(ap, 0, sizeof(ap));
+    ap[0].buffer_type = MYSQL_TYPE_LONG;     ap[0].buffer = &userId; ap[0].is_unsigned = 1;
+    ap[1].buffer_type = MYSQL_TYPE_LONGLONG; ap[1].buffer = &amountCents;
+    ap[2].buffer_type = MYSQL_TYPE_LONG;     ap[2].buffer = &itemId; ap[2].is_unsigned = 1;
+    db.execute(sqlActivity, ap, 3);
+
+    // The item's memoized price is now stale for this request too
+    ctx.forgetItem(itemId);
+    return { Outcome::Placed, amount };
+}
@@ -0,0 +1,46 @@
+// core/BidPlacement.hpp
+#pragma once
+
+#include <string>
+#include "core/RequestContext.hpp"
+#include "utils/Money.hpp"
+
+// =============================================================
+// BidPlacement — Team Elevate Auctions
+// The bid write path shared by bid.cgi and /api/bids: admission
+// control, business rules against a direct item lookup, the
+// INSERT, the items leader update, activity bookkeeping, cache
+// invalidation and the live-update event. Callers turn the
+// Outcome into HTML or JSON.
+// =============================================================
+class BidPlacement {
+public:
+    enum class Outcome {
+        Placed,
+        NotLoggedIn,
+        Throttled,      // retryAfter is set
+        NoSuchItem,
+        OwnItem,
+        NotActive,
+        TooLow,         // floor is set
+        Failed          // error is set
+    };
+
+    struct Result {
+        Outcome outcome;
+        Money floor;              // price the bid had to beat
+        unsigned retryAfter = 0;  // seconds, for Throttled
+        std::string error;        // driver message, for Failed
+    };
+
+    // `itemId` and `amount` are already syntactically valid
+    // (positive id, positive amount).
+    // Every outcome is counted in Metrics (auction_bids_total).
+    static Result place(RequestContext& ctx, long itemId, Money amount);
+
+    // Current leader lookup (checked by make plan-test)
+    static const char* const kTopBidSql;
+
+private:
+    static Result attempt(RequestContext& ctx, long itemId, Money amount);
+};
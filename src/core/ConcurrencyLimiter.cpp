@@ -0,0 +1,91 @@
+// core/ConcurrencyLimiter.cpp
+#include "core/ConcurrencyLimiter.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+static unsigned envUnsigned(const char* name, unsigned fallback) {
+    const char* v = name ? std::getenv(name) : nullptr;
+    if (!v || !*v) return fallback;
+    unsigned out = 0;
+    const char* end = v + std::strlen(v);
+    auto [ptr, ec] = std::from_chars(v, end, out);
+    return (ec == std::errc() && ptr == end) ? out : fallback;
+}
+
+static long elapsedMs(const timespec& since) {
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - since.tv_sec) * 1000L + (now.tv_nsec - since.tv_nsec) / 1000000L;
+}
+
+ConcurrencyLimiter::ConcurrencyLimiter(std::string_view name, unsigned slots)
+    : slots_(slots ? slots : 1) {
+    const char* dir = std::getenv("AUCTION_LOCK_DIR");
+    prefix_ = (dir && *dir) ? dir : "/dev/shm";
+    prefix_ += "/auction-";
+    prefix_ += name;
+    prefix_ += '-';
+}
+
+ConcurrencyLimiter::~ConcurrencyLimiter() {
+    release();
+}
+
+// -------------------------------------------------------------
+// One non-blocking pass over the slots, starting at a per-process
+// offset so concurrent workers do not all contend for slot 0
+// -------------------------------------------------------------
+bool ConcurrencyLimiter::tryAny() {
+    const unsigned start = static_cast<unsigned>(getpid()) % slots_;
+    for (unsigned i = 0; i < slots_; ++i) {
+        std::string path = prefix_ + std::to_string((start + i) % slots_) + ".lock";
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (fd < 0) return false;
+        if (flock(fd, LOCK_EX | LOCK_NB) == 0) {
+            fd_ = fd;
+            return true;
+        }
+        close(fd);
+    }
+    return false;
+}
+
+bool ConcurrencyLimiter::acquire(unsigned timeoutMs) {
+    if (held()) return true;
+
+    timespec started{};
+    clock_gettime(CLOCK_MONOTONIC, &started);
+
+    // Poll with a short capped backoff; flock() has no timed wait
+    long sleepUs = 1000;
+    while (!tryAny()) {
+        if (elapsedMs(started) >= static_cast<long>(timeoutMs))
+            return false;
+        usleep(static_cast<useconds_t>(sleepUs));
+        if (sleepUs < 16000) sleepUs *= 2;
+    }
+    return true;
+}
+
+void ConcurrencyLimiter::release() {
+    if (fd_ >= 0) {
+        close(fd_);   // drops the flock
+        fd_ = -1;
+    }
+}
+
+unsigned ConcurrencyLimiter::slotsFromEnv(const char* envName) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned fallback = cpus > 1 ? static_cast<unsigned>(cpus / 2) : 1;
+    unsigned n = envUnsigned(envName, fallback);
+    return n ? n : 1;
+}
+
+unsigned ConcurrencyLimiter::timeoutFromEnv(const char* envName, unsigned fallbackMs) {
+    return envUnsigned(envName, fallbackMs);
+}
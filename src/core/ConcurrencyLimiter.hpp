@@ -0,0 +1,47 @@
+// core/ConcurrencyLimiter.hpp
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// =============================================================
+// ConcurrencyLimiter — Team Elevate Auctions
+// Cross-process semaphore for CGI workers. Each of `slots` slots
+// is a lock file (<dir>/auction-<name>-<n>.lock); holding an
+// exclusive flock() on one is holding the slot. The kernel drops
+// the lock when the process exits, so a crashed or killed CGI
+// can never leak a slot.
+//
+// Callers that cannot get a slot within their queue timeout
+// should shed the request (503/429 + Retry-After) rather than
+// pile more CPU-bound work onto the host.
+// =============================================================
+class ConcurrencyLimiter {
+public:
+    // Lock files live in AUCTION_LOCK_DIR (default /dev/shm).
+    ConcurrencyLimiter(std::string_view name, unsigned slots);
+    ~ConcurrencyLimiter();
+
+    ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+    ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+    // Take a free slot, polling for up to `timeoutMs`.
+    // False when every slot stayed busy (or the lock dir is unusable).
+    bool acquire(unsigned timeoutMs);
+    void release();
+
+    bool held() const noexcept { return fd_ >= 0; }
+
+    // Slot count from `envName`, else max(1, online CPUs / 2)
+    static unsigned slotsFromEnv(const char* envName);
+
+    // Queue timeout from `envName`, else `fallbackMs`
+    static unsigned timeoutFromEnv(const char* envName, unsigned fallbackMs);
+
+private:
+    std::string prefix_;
+    unsigned slots_;
+    int fd_ = -1;
+
+    bool tryAny();
+};
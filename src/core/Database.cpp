@@ -1,49 +1,190 @@
 #include "Database.hpp"
+#include "core/Metrics.hpp"
+#include "core/SharedSegment.hpp"
+#include "core/Statement.hpp"
+#include "core/Trace.hpp"
+#include "utils/utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <cstdlib>
 #include <stdexcept>
+#include <string_view>
+#include <unistd.h>
 
 // =============================================================
 // Database  Team Elevate Auctions
 // Handles safe MySQL connection initialization and cleanup.
 // =============================================================
 
-Database::Database(const std::string& host,
-    const std::string& user,
-    const std::string& pass,
-    const std::string& db,
-    unsigned int port)
-    : conn_(nullptr)
-{
-    conn_ = mysql_init(nullptr);
-    if (!conn_) {
-        throw std::runtime_error("MySQL initialization failed.");
+namespace {
+
+// Replica connects give up fast; the primary is the fallback
+constexpr unsigned kReplicaConnectTimeoutS = 1;
+
+// -------------------------------------------------------------
+// Host-wide replica health, so one process pays for a dead or
+// lagging replica instead of every request: a verdict per
+// configured replica, re-checked after its TTL
+// -------------------------------------------------------------
+enum Health : std::uint32_t { Unknown = 0, Healthy = 1, Unhealthy = 2 };
+
+constexpr unsigned kHealthSlots = 8;
+constexpr std::int64_t kHealthyTtlMs = 1000;
+constexpr std::int64_t kUnhealthyTtlMs = 5000;
+
+struct HealthSlot {
+    std::int64_t checkedAtMs;
+    std::uint32_t state;
+};
+
+struct HealthLayout {
+    HealthSlot slots[kHealthSlots];
+};
+
+const char* kHealthSegmentName = "replica-health-v1";
+
+HealthSlot* healthSlot(std::size_t replica) {
+    static SharedSegment segment(kHealthSegmentName, sizeof(HealthLayout));
+    HealthLayout* shm = segment.as<HealthLayout>();
+    return shm && replica < kHealthSlots ? &shm->slots[replica] : nullptr;
+}
+
+std::int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Cached verdict still within its TTL, else Unknown
+Health cachedHealth(std::size_t replica) {
+    HealthSlot* slot = healthSlot(replica);
+    if (!slot) return Unknown;
+    const std::int64_t at = std::atomic_ref<std::int64_t>(slot->checkedAtMs).load(std::memory_order_acquire);
+    const auto state = static_cast<Health>(std::atomic_ref<std::uint32_t>(slot->state).load(std::memory_order_acquire));
+    const std::int64_t ttl = state == Healthy ? kHealthyTtlMs : kUnhealthyTtlMs;
+    return state != Unknown && nowMs() - at < ttl ? state : Unknown;
+}
+
+void storeHealth(std::size_t replica, Health h) {
+    if (HealthSlot* slot = healthSlot(replica)) {
+        std::atomic_ref<std::uint32_t>(slot->state).store(h, std::memory_order_release);
+        std::atomic_ref<std::int64_t>(slot->checkedAtMs).store(nowMs(), std::memory_order_release);
+    }
+}
+
+MYSQL* connectTo(const DbConfig& cfg, const DbConfig::Endpoint& at, unsigned timeoutS, std::string& err) {
+    MYSQL* conn = mysql_init(nullptr);
+    if (!conn) {
+        err = "MySQL initialization failed.";
+        return nullptr;
     }
 
     // Optional: enable automatic reconnect
     my_bool reconnect = 1;
-    mysql_options(conn_, MYSQL_OPT_RECONNECT, &reconnect);
+    mysql_options(conn, MYSQL_OPT_RECONNECT, &reconnect);
+    if (timeoutS) mysql_options(conn, MYSQL_OPT_CONNECT_TIMEOUT, &timeoutS);
+
+    if (!mysql_real_connect(conn,
+        at.host.c_str(),
+        cfg.user.c_str(),
+        cfg.password.c_str(),
+        cfg.database.c_str(),
+        at.port, nullptr, 0)) {
+        err = std::string("DB connection failed: ") + mysql_error(conn);
+        mysql_close(conn);
+        return nullptr;
+    }
+    return conn;
+}
+
+// -------------------------------------------------------------
+// Seconds_Behind_Master within `maxLag`. A replica that cannot
+// report (no REPLICATION CLIENT privilege) is trusted; one with
+// replication stopped (NULL) is not.
+// -------------------------------------------------------------
+bool lagWithin(MYSQL* conn, unsigned maxLag) {
+    const std::string_view sql = "SHOW SLAVE STATUS";
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) return true;
+    MYSQL_RES* res = mysql_store_result(conn);
+    if (!res) return true;
+
+    bool ok = false;
+    const unsigned n = mysql_num_fields(res);
+    MYSQL_FIELD* fields = mysql_fetch_fields(res);
+    if (MYSQL_ROW row = mysql_fetch_row(res)) {
+        for (unsigned i = 0; i < n; ++i) {
+            if (std::string_view(fields[i].name) == "Seconds_Behind_Master") {
+                ok = row[i] && std::strtoul(row[i], nullptr, 10) <= maxLag;
+                break;
+            }
+        }
+    }
+    mysql_free_result(res);
+    return ok;
+}
+
+// db_pos cookie of this request: a GTID list with ',' as '_',
+// or "primary"; anything else is ignored
+std::string requestPosition() {
+    const char* cookies = std::getenv("HTTP_COOKIE");
+    if (!cookies) return {};
+    std::string pos = getCookieValue(cookies, Database::kPositionCookie);
+    if (pos == "primary") return pos;
+    for (char& c : pos) {
+        if (c == '_') c = ',';
+        else if ((c < '0' || c > '9') && c != '-') return {};
+    }
+    return pos;
+}
+
+// The replica has applied `gtid`, waiting up to `waitMs`
+bool caughtUp(MYSQL* conn, const std::string& gtid, unsigned waitMs) {
+    char timeout[32];
+    std::snprintf(timeout, sizeof(timeout), "%.3f", waitMs / 1000.0);
+    const std::string sql = "SELECT MASTER_GTID_WAIT('" + gtid + "', " + timeout + ")";
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) return false;
+    MYSQL_RES* res = mysql_store_result(conn);
+    if (!res) return false;
+    MYSQL_ROW row = mysql_fetch_row(res);
+    const bool ok = row && row[0] && std::string_view(row[0]) == "0";
+    mysql_free_result(res);
+    return ok;
+}
+
+} // namespace
 
+Database::Database(const DbConfig& cfg)
+    : cfg_(cfg), conn_(nullptr)
+{
     // ---------------------------------------------------------
-    // Try to connect using provided credentials
+    // Try to connect to the primary using configured credentials
     // ---------------------------------------------------------
-    if (!mysql_real_connect(conn_,
-        host.c_str(),
-        user.c_str(),
-        pass.c_str(),
-        db.c_str(),
-        port, nullptr, 0)) {
-        std::string err = mysql_error(conn_);
-        mysql_close(conn_);
-        conn_ = nullptr;
-        throw std::runtime_error("DB connection failed: " + err);
+    Trace::Span span("db-connect");
+    std::string err;
+    if (const std::string missing = cfg_.missing(); !missing.empty()) {
+        // CGI mains only show a generic error page: say why in the server log
+        err = "DB not configured: set " + missing + " (or their keys in the AUCTION_DB_CONFIG file)";
+        std::fprintf(stderr, "%s\n", err.c_str());
+        Metrics::add(Metrics::DbConnectError);
+        throw std::runtime_error(err);
+    }
+    conn_ = connectTo(cfg_, cfg_.primary, 0, err);
+    if (!conn_) {
+        Metrics::add(Metrics::DbConnectError);
+        throw std::runtime_error(err);
     }
 }
 
 // -------------------------------------------------------------
-// Destructor  closes the connection safely
+// Destructor  closes the connections safely
 // -------------------------------------------------------------
 Database::~Database() {
+    if (replica_) {
+        mysql_close(replica_);
+        replica_ = nullptr;
+    }
     if (conn_) {
         mysql_close(conn_);
         conn_ = nullptr;
@@ -55,33 +196,103 @@ Database::~Database() {
 // -------------------------------------------------------------
 bool Database::execute(const std::string& sql,
     MYSQL_BIND* params,
-    unsigned int count)
+    unsigned int count,
+    Route route)
 {
     if (!conn_) return false;
 
-    MYSQL_STMT* stmt = mysql_stmt_init(conn_);
-    if (!stmt) return false;
+    Statement stmt(*this, sql, route);
+    if (!stmt.ok()) return false;
 
-    if (mysql_stmt_prepare(stmt, sql.c_str(), sql.size()) != 0) {
-        mysql_stmt_close(stmt);
+    if (params && count > 0 && !stmt.bindParams(params))
         return false;
+
+    return stmt.execute();
+}
+
+// -------------------------------------------------------------
+// Getter for internal MYSQL connection
+// -------------------------------------------------------------
+MYSQL* Database::connection() const noexcept {
+    return conn_;
+}
+
+MYSQL* Database::connection(Route route) {
+    if (route != Route::Replica || cfg_.replicas.empty() || wrote_)
+        return conn_;
+    if (replicaState_ == 0) {
+        replicaState_ = openReplica() ? 1 : -1;
+        if (replicaState_ < 0) Metrics::add(Metrics::ReplicaFallback);
     }
+    return replicaState_ > 0 ? replica_ : conn_;
+}
+
+// -------------------------------------------------------------
+// First replica read of the request: start at pid % n so
+// processes spread over the replicas, skip those known to be
+// down or lagging, then honour the caller's db_pos
+// -------------------------------------------------------------
+bool Database::openReplica() {
+    const std::string position = requestPosition();
+    if (position == "primary") return false;
+
+    Trace::Span span("db-connect", "replica");
+    const std::size_t n = cfg_.replicas.size();
+    const std::size_t start = static_cast<std::size_t>(getpid()) % n;
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t i = (start + k) % n;
+        const Health cached = cachedHealth(i);
+        if (cached == Unhealthy) continue;
+
+        std::string err;
+        MYSQL* conn = connectTo(cfg_, cfg_.replicas[i], kReplicaConnectTimeoutS, err);
+        if (!conn) {
+            Metrics::add(Metrics::DbConnectError);
+            storeHealth(i, Unhealthy);
+            continue;
+        }
+        if (cached != Healthy) {
+            const bool ok = cfg_.maxLagSeconds == 0 || lagWithin(conn, cfg_.maxLagSeconds);
+            storeHealth(i, ok ? Healthy : Unhealthy);
+            if (!ok) {
+                mysql_close(conn);
+                continue;
+            }
+        }
 
-    if (params && count > 0) {
-        if (mysql_stmt_bind_param(stmt, params) != 0) {
-            mysql_stmt_close(stmt);
+        // Behind this user's own writes: the primary answers
+        // this request (other replicas are no further along)
+        if (!position.empty() && !caughtUp(conn, position, cfg_.rywWaitMs)) {
+            mysql_close(conn);
             return false;
         }
+        replica_ = conn;
+        return true;
     }
-
-    bool success = (mysql_stmt_execute(stmt) == 0);
-    mysql_stmt_close(stmt);
-    return success;
+    return false;
 }
 
 // -------------------------------------------------------------
-// Getter for internal MYSQL connection
+// Read once, after the request's writes: MariaDB's @@last_gtid
+// names this connection's last transaction
 // -------------------------------------------------------------
-MYSQL* Database::connection() const noexcept {
-    return conn_;
+const std::string& Database::writePosition() {
+    if (positionRead_ || !wrote_ || cfg_.replicas.empty() || !conn_)
+        return position_;
+    positionRead_ = true;
+
+    const std::string_view sql = "SELECT @@last_gtid";
+    if (mysql_real_query(conn_, sql.data(), sql.size()) == 0) {
+        if (MYSQL_RES* res = mysql_store_result(conn_)) {
+            MYSQL_ROW row = mysql_fetch_row(res);
+            if (row && row[0]) position_ = row[0];
+            mysql_free_result(res);
+        }
+    }
+    for (char& c : position_) {
+        if (c == ',') c = '_';
+        else if ((c < '0' || c > '9') && c != '-') { position_.clear(); break; }
+    }
+    if (position_.empty()) position_ = "primary";
+    return position_;
 }
@@ -1,14 +1,32 @@
 #pragma once
 #include <mysql/mysql.h>
 #include <string>
+#include "core/DbConfig.hpp"
+
+// Per-connection counters, read by RequestContext::report()
+struct QueryStats {
+    unsigned statements = 0;   // statements prepared
+    unsigned roundTrips = 0;   // client/server exchanges (prepare, execute, result transfer)
+    unsigned rows = 0;         // rows fetched
+};
 
 class Database {
 public:
-    explicit Database(const std::string& host = "localhost",
-        const std::string& user = "cs370_section2_elevate",
-        const std::string& pass = "etavele_004",
-        const std::string& db = "cs370_section2_elevate",
-        unsigned int port = 0);
+    // Where a statement runs
+    enum class Route {
+        Primary,        // writes, and reads that must be current
+        Replica,        // read-only, may trail the primary (see connection())
+        Housekeeping    // primary write nobody reads back (last_active
+                        // refresh): does not pin reads to the primary
+    };
+
+    // Read-your-writes cookie: the primary's GTID after a write
+    // (',' stored as '_'), or "primary" when it is unknown
+    static constexpr const char* kPositionCookie = "db_pos";
+    static constexpr unsigned kPositionCookieMaxAge = 60;
+
+    // Connects to the primary now; replicas on first use
+    explicit Database(const DbConfig& cfg = DbConfig::get());
 
     ~Database();
 
@@ -17,10 +35,37 @@ public:
 
     bool execute(const std::string& sql,
         MYSQL_BIND* params = nullptr,
-        unsigned int count = 0);
+        unsigned int count = 0,
+        Route route = Route::Primary);
 
+    // The primary connection
     MYSQL* connection() const noexcept;
 
+    // Connection for `route`. Replica reads use a replica that is
+    // reachable, within maxLagSeconds and caught up with the
+    // request's db_pos cookie (waiting up to rywWaitMs); once this
+    // request has written, or when no replica qualifies, they go
+    // to the primary.
+    MYSQL* connection(Route route);
+
+    // Statement reports each tracked write on the primary
+    void noteWrite() noexcept { wrote_ = true; }
+
+    // Value for the db_pos cookie, or empty when this request
+    // wrote nothing or there are no replicas to lag behind
+    const std::string& writePosition();
+
+    QueryStats& stats() noexcept { return stats_; }
+
 private:
+    const DbConfig& cfg_;
     MYSQL* conn_;
+    MYSQL* replica_ = nullptr;
+    int replicaState_ = 0;        // 0 = not tried, 1 = replica_ open, -1 = use primary
+    bool wrote_ = false;
+    bool positionRead_ = false;
+    std::string position_;
+    QueryStats stats_;
+
+    bool openReplica();
 };
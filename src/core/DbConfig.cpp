@@ -0,0 +1,130 @@
+// core/DbConfig.cpp
+#include "core/DbConfig.hpp"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\r')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+bool parseUnsigned(std::string_view text, unsigned& out) {
+    unsigned v = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), v);
+    if (text.empty() || ec != std::errc() || ptr != text.data() + text.size()) return false;
+    out = v;
+    return true;
+}
+
+void loadFile(DbConfig& cfg, const char* path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "db config: cannot open %s; using the environment only\n", path);
+        return;
+    }
+    std::string line;
+    unsigned lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::string_view l = trim(line);
+        if (l.empty() || l.front() == '#') continue;
+        const std::size_t eq = l.find('=');
+        if (eq == std::string_view::npos || !cfg.set(trim(l.substr(0, eq)), trim(l.substr(eq + 1))))
+            std::fprintf(stderr, "db config: %s:%u: ignoring bad line\n", path, lineNo);
+    }
+}
+
+// Environment overrides: variable -> config key
+void loadEnv(DbConfig& cfg) {
+    static const char* const kVars[][2] = {
+        { "AUCTION_DB_HOST",        "host" },
+        { "AUCTION_DB_PORT",        "port" },
+        { "AUCTION_DB_USER",        "user" },
+        { "AUCTION_DB_PASSWORD",    "password" },
+        { "AUCTION_DB_NAME",        "database" },
+        { "AUCTION_DB_MAX_LAG_S",   "max_lag_s" },
+        { "AUCTION_DB_RYW_WAIT_MS", "ryw_wait_ms" },
+    };
+    for (const auto& v : kVars) {
+        const char* value = std::getenv(v[0]);
+        if (value && !cfg.set(v[1], value))
+            std::fprintf(stderr, "db config: ignoring bad %s\n", v[0]);
+    }
+
+    // The list replaces the file's replicas; empty means none
+    if (const char* list = std::getenv("AUCTION_DB_REPLICAS")) {
+        cfg.replicas.clear();
+        std::string_view rest = list;
+        while (!rest.empty()) {
+            const std::size_t comma = rest.find(',');
+            const std::string_view item = trim(rest.substr(0, comma));
+            if (!item.empty() && !cfg.set("replica", item))
+                std::fprintf(stderr, "db config: ignoring bad replica '%.*s'\n",
+                    static_cast<int>(item.size()), item.data());
+            rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+        }
+    }
+}
+
+} // namespace
+
+bool DbConfig::parseEndpoint(std::string_view text, Endpoint& out) {
+    const std::size_t colon = text.rfind(':');
+    Endpoint e;
+    e.host.assign(text.substr(0, colon));
+    if (colon != std::string_view::npos && !parseUnsigned(text.substr(colon + 1), e.port))
+        return false;
+    if (e.host.empty()) return false;
+    out = std::move(e);
+    return true;
+}
+
+bool DbConfig::set(std::string_view key, std::string_view value) {
+    if (key == "host") {
+        if (value.empty()) return false;
+        primary.host.assign(value);
+        return true;
+    }
+    if (key == "port") return parseUnsigned(value, primary.port);
+    if (key == "user") { user.assign(value); return true; }
+    if (key == "password") { password.assign(value); return true; }
+    if (key == "database") { database.assign(value); return true; }
+    if (key == "max_lag_s") return parseUnsigned(value, maxLagSeconds);
+    if (key == "ryw_wait_ms") return parseUnsigned(value, rywWaitMs);
+    if (key == "replica") {
+        Endpoint e;
+        if (!parseEndpoint(value, e)) return false;
+        replicas.push_back(std::move(e));
+        return true;
+    }
+    return false;
+}
+
+std::string DbConfig::missing() const {
+    std::string out;
+    const auto need = [&out](const std::string& value, const char* var) {
+        if (!value.empty()) return;
+        if (!out.empty()) out += ", ";
+        out += var;
+    };
+    need(user, "AUCTION_DB_USER");
+    need(password, "AUCTION_DB_PASSWORD");
+    need(database, "AUCTION_DB_NAME");
+    return out;
+}
+
+const DbConfig& DbConfig::get() {
+    static const DbConfig cfg = [] {
+        DbConfig c;
+        if (const char* path = std::getenv("AUCTION_DB_CONFIG"); path && *path)
+            loadFile(c, path);
+        loadEnv(c);
+        return c;
+    }();
+    return cfg;
+}
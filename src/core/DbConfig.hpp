@@ -0,0 +1,71 @@
+// core/DbConfig.hpp
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =============================================================
+// DbConfig — Team Elevate Auctions
+// Where Database connects: one primary for writes (and reads
+// that must be current) plus optional read replicas.
+//
+// Read once per process, in this order, later sources winning:
+//
+//  1. built-in defaults (localhost, no account)
+//  2. the file named by AUCTION_DB_CONFIG, `key = value` lines,
+//     '#' comments, `replica` repeatable:
+//
+//        host = db1.internal
+//        port = 3306
+//        user = auction
+//        password = ...
+//        database = auction
+//        replica = db2.internal:3306
+//        replica = db3.internal
+//        max_lag_s = 5
+//        ryw_wait_ms = 200
+//
+//  3. AUCTION_DB_HOST, _PORT, _USER, _PASSWORD, _NAME,
+//     _REPLICAS (comma-separated host[:port]), _MAX_LAG_S and
+//     _RYW_WAIT_MS
+//
+// A malformed file or value is reported on stderr and ignored.
+// There are no default credentials: user, password and database
+// must come from the file or the environment, and Database
+// refuses to start without them.
+// =============================================================
+struct DbConfig {
+    struct Endpoint {
+        std::string host;
+        unsigned port = 0;        // 0 = client default
+    };
+
+    Endpoint primary{ "localhost", 0 };
+    std::vector<Endpoint> replicas;
+    std::string user;
+    std::string password;
+    std::string database;
+
+    // A replica further behind than this (Seconds_Behind_Master)
+    // is skipped; 0 disables the lag check
+    unsigned maxLagSeconds = 5;
+
+    // How long a replica may take to catch up to the caller's
+    // read-your-writes position before reads go to the primary
+    unsigned rywWaitMs = 200;
+
+    // The process-wide configuration (parsed on first use)
+    static const DbConfig& get();
+
+    // Apply one `key = value` setting; false for an unknown key
+    // or a bad value
+    bool set(std::string_view key, std::string_view value);
+
+    // Environment names of the required settings still unset
+    // ("AUCTION_DB_USER, AUCTION_DB_PASSWORD"); empty when complete
+    std::string missing() const;
+
+    // "host[:port]"; false when the port is not a number
+    static bool parseEndpoint(std::string_view text, Endpoint& out);
+};
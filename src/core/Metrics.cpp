@@ -0,0 +1,202 @@
+// core/Metrics.cpp
+#include "core/Metrics.hpp"
+#include "core/SharedSegment.hpp"
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <ostream>
+#include <unistd.h>
+
+namespace {
+
+constexpr unsigned kSubBits = std::countr_zero(Metrics::kSubBuckets);
+static_assert((1u << kSubBits) == Metrics::kSubBuckets, "kSubBuckets must be a power of two");
+
+struct alignas(64) Histogram {
+    std::uint64_t buckets[Metrics::kBuckets];
+    std::uint64_t sumUs;
+};
+
+struct alignas(64) Shard {
+    std::uint64_t counters[Metrics::kCounters];
+    Histogram requests[Metrics::kPageCount];
+    Histogram queries;
+};
+
+struct Layout {
+    Shard shards[Metrics::kShards];
+};
+
+const char* kSegmentName = "metrics-v4";
+
+// Mapped once per process on first use
+Layout* layout() {
+    static SharedSegment segment(kSegmentName, sizeof(Layout));
+    return segment.as<Layout>();
+}
+
+Shard* myShard() {
+    Layout* shm = layout();
+    return shm ? &shm->shards[static_cast<unsigned>(getpid()) % Metrics::kShards] : nullptr;
+}
+
+void bump(std::uint64_t& cell, std::uint64_t n) {
+    std::atomic_ref<std::uint64_t>(cell).fetch_add(n, std::memory_order_relaxed);
+}
+
+std::uint64_t load(const std::uint64_t& cell) {
+    return std::atomic_ref<std::uint64_t>(const_cast<std::uint64_t&>(cell)).load(std::memory_order_relaxed);
+}
+
+void observe(Histogram& h, long long durNs) {
+    const std::uint64_t us = durNs > 0 ? static_cast<std::uint64_t>(durNs) / 1000 : 0;
+    bump(h.buckets[Metrics::bucketOf(us)], 1);
+    bump(h.sumUs, us);
+}
+
+// Page index from SCRIPT_NAME: basename without ".cgi"
+unsigned pageIndex(std::string_view script) {
+    std::size_t slash = script.rfind('/');
+    if (slash != std::string_view::npos) script.remove_prefix(slash + 1);
+    if (script.size() > 4 && script.substr(script.size() - 4) == ".cgi")
+        script.remove_suffix(4);
+    for (unsigned i = 0; i + 1 < Metrics::kPageCount; ++i) {
+        if (script == Metrics::kPages[i]) return i;
+    }
+    return Metrics::kPageCount - 1;
+}
+
+// Sum of one histogram across shards
+struct Merged {
+    std::uint64_t buckets[Metrics::kBuckets] = {};
+    std::uint64_t sumUs = 0;
+    std::uint64_t count = 0;
+
+    // count is summed from the buckets rather than read, so the
+    // +Inf bucket and _count always agree within one scrape
+    void add(const Histogram& h) {
+        for (unsigned b = 0; b < Metrics::kBuckets; ++b) {
+            const std::uint64_t n = load(h.buckets[b]);
+            buckets[b] += n;
+            count += n;
+        }
+        sumUs += load(h.sumUs);
+    }
+};
+
+// Cumulative `le` buckets at octave edges from 128 µs upward,
+// so each `le` is an exact bucket boundary
+void writeHistogram(std::ostream& out, const char* name, const char* labels, const Merged& h) {
+    // Sized for the longest name and label set; n is clamped anyway
+    char buf[512];
+    auto emit = [&](int n) { if (n > 0) out.write(buf, n < static_cast<int>(sizeof(buf)) ? n : sizeof(buf) - 1); };
+    const char* sep = *labels ? "," : "";
+    std::uint64_t cumulative = 0;
+    unsigned next = 0;
+    for (unsigned octave = 7; octave <= Metrics::kOctaves + 2; ++octave) {
+        const unsigned edge = (octave - 2) * Metrics::kSubBuckets;   // first bucket of [2^octave, ...)
+        for (; next < edge; ++next) cumulative += h.buckets[next];
+        int n = std::snprintf(buf, sizeof(buf), "%s_bucket{%s%sle=\"%.6f\"} %llu\n", name, labels, sep,
+            static_cast<double>(1ULL << octave) / 1e6, static_cast<unsigned long long>(cumulative));
+        emit(n);
+    }
+    const char* open = *labels ? "{" : "";
+    const char* close = *labels ? "}" : "";
+    int n = std::snprintf(buf, sizeof(buf),
+        "%s_bucket{%s%sle=\"+Inf\"} %llu\n%s_sum%s%s%s %.6f\n%s_count%s%s%s %llu\n",
+        name, labels, sep, static_cast<unsigned long long>(h.count),
+        name, open, labels, close, static_cast<double>(h.sumUs) / 1e6,
+        name, open, labels, close, static_cast<unsigned long long>(h.count));
+    emit(n);
+}
+
+} // namespace
+
+void Metrics::add(Counter c, std::uint64_t n) {
+    if (Shard* s = myShard()) bump(s->counters[c], n);
+}
+
+void Metrics::observeRequest(std::string_view script, long long durNs) {
+    if (Shard* s = myShard()) observe(s->requests[pageIndex(script)], durNs);
+}
+
+void Metrics::observeQuery(long long durNs) {
+    if (Shard* s = myShard()) observe(s->queries, durNs);
+}
+
+// -------------------------------------------------------------
+// 0..7 map to themselves; from 8 up, the octave picks a group of
+// kSubBuckets buckets and the next kSubBits bits pick within it
+// -------------------------------------------------------------
+unsigned Metrics::bucketOf(std::uint64_t us) noexcept {
+    if (us < kSubBuckets) return static_cast<unsigned>(us);
+    const unsigned octave = static_cast<unsigned>(std::bit_width(us)) - 1;
+    const unsigned bucket = (octave - kSubBits + 1) * kSubBuckets +
+        static_cast<unsigned>((us >> (octave - kSubBits)) & (kSubBuckets - 1));
+    return bucket < kBuckets ? bucket : kBuckets - 1;
+}
+
+std::uint64_t Metrics::bucketFloor(unsigned bucket) noexcept {
+    if (bucket < kSubBuckets) return bucket;
+    const unsigned octave = bucket / kSubBuckets + kSubBits - 1;
+    return static_cast<std::uint64_t>(kSubBuckets + bucket % kSubBuckets) << (octave - kSubBits);
+}
+
+// -------------------------------------------------------------
+// Prometheus text exposition (version 0.0.4)
+// -------------------------------------------------------------
+void Metrics::writePrometheus(std::ostream& out) {
+    Layout* shm = layout();
+    if (!shm) return;
+
+    std::uint64_t counters[kCounters] = {};
+    for (const Shard& s : shm->shards) {
+        for (unsigned c = 0; c < kCounters; ++c) counters[c] += load(s.counters[c]);
+    }
+
+    static const char* const kBidOutcomes[] = {
+        "placed", "not_logged_in", "throttled", "no_such_item",
+        "own_item", "not_active", "too_low", "failed"
+    };
+    static const char* const kDbErrors[] = { "connect", "prepare", "execute" };
+    static_assert(BidPlaced + sizeof(kBidOutcomes) / sizeof(kBidOutcomes[0]) == DbConnectError);
+    static_assert(DbConnectError + sizeof(kDbErrors) / sizeof(kDbErrors[0]) == SessionsPurged);
+
+    out << "# HELP auction_bids_total Bid attempts by outcome.\n"
+        << "# TYPE auction_bids_total counter\n";
+    for (unsigned i = 0; i < DbConnectError - BidPlaced; ++i)
+        out << "auction_bids_total{outcome=\"" << kBidOutcomes[i] << "\"} " << counters[BidPlaced + i] << "\n";
+
+    out << "# HELP auction_db_errors_total Failed database operations by kind.\n"
+        << "# TYPE auction_db_errors_total counter\n";
+    for (unsigned i = 0; i < SessionsPurged - DbConnectError; ++i)
+        out << "auction_db_errors_total{kind=\"" << kDbErrors[i] << "\"} " << counters[DbConnectError + i] << "\n";
+
+    out << "# HELP auction_sessions_purged_total Expired sessions deleted by sweep_sessions.\n"
+        << "# TYPE auction_sessions_purged_total counter\n"
+        << "auction_sessions_purged_total " << counters[SessionsPurged] << "\n";
+
+    out << "# HELP auction_db_replica_fallbacks_total Requests whose replica reads went to the primary.\n"
+        << "# TYPE auction_db_replica_fallbacks_total counter\n"
+        << "auction_db_replica_fallbacks_total " << counters[ReplicaFallback] << "\n";
+
+    out << "# HELP auction_schema_missing_indexes_total Expected indexes found missing, per schema check.\n"
+        << "# TYPE auction_schema_missing_indexes_total counter\n"
+        << "auction_schema_missing_indexes_total " << counters[SchemaIndexMissing] << "\n";
+
+    out << "# HELP auction_request_duration_seconds CGI request latency by page.\n"
+        << "# TYPE auction_request_duration_seconds histogram\n";
+    for (unsigned p = 0; p < kPageCount; ++p) {
+        Merged h;
+        for (const Shard& s : shm->shards) h.add(s.requests[p]);
+        char labels[48];
+        std::snprintf(labels, sizeof(labels), "page=\"%s\"", kPages[p]);
+        writeHistogram(out, "auction_request_duration_seconds", labels, h);
+    }
+
+    out << "# HELP auction_db_query_duration_seconds Statement execute latency.\n"
+        << "# TYPE auction_db_query_duration_seconds histogram\n";
+    Merged q;
+    for (const Shard& s : shm->shards) q.add(s.queries);
+    writeHistogram(out, "auction_db_query_duration_seconds", "", q);
+}
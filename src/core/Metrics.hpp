@@ -0,0 +1,75 @@
+// core/Metrics.hpp
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+// =============================================================
+// Metrics — Team Elevate Auctions
+// Host-wide counters and latency histograms in a SharedSegment,
+// updated lock-free by every CGI process and merged by
+// metrics.cgi into Prometheus text format.
+//
+//  - The segment holds kShards shards, each aligned to a cache
+//    line; a process writes only to shard (pid % kShards), so
+//    concurrent CGIs rarely touch the same lines. Updates are
+//    relaxed atomic adds; the scrape sums every shard.
+//  - Histograms are HDR-style: values in µs, bucketed by power
+//    of two with kSubBuckets linear steps inside each, so every
+//    bucket is within 1/kSubBuckets of the values it holds, from
+//    1 µs to ~2 min. The export reports the octave edges as
+//    Prometheus `le` buckets.
+//
+// A missing segment turns every call into a no-op.
+// =============================================================
+class Metrics {
+public:
+    enum Counter : unsigned {
+        BidPlaced,
+        BidNotLoggedIn,
+        BidThrottled,
+        BidNoSuchItem,
+        BidOwnItem,
+        BidNotActive,
+        BidTooLow,
+        BidFailed,
+        DbConnectError,
+        DbPrepareError,
+        DbExecuteError,
+        SessionsPurged,
+        ReplicaFallback,
+        SchemaIndexMissing,
+        kCounters
+    };
+
+    // Request latency is kept per page (SCRIPT_NAME basename);
+    // unknown scripts count as "other"
+    static constexpr const char* kPages[] = {
+        "index", "login", "register", "logout", "browse", "bid",
+        "sell", "transactions", "api", "other"
+    };
+    static constexpr unsigned kPageCount = sizeof(kPages) / sizeof(kPages[0]);
+
+    static constexpr unsigned kShards = 16;
+    static constexpr unsigned kSubBuckets = 8;
+    static constexpr unsigned kOctaves = 24;      // octaves above the linear 0..7 µs
+    static constexpr unsigned kBuckets = kSubBuckets * (kOctaves + 1);
+
+    static void add(Counter c, std::uint64_t n = 1);
+
+    // One finished request of SCRIPT_NAME `script`
+    static void observeRequest(std::string_view script, long long durNs);
+
+    // One statement execute round trip
+    static void observeQuery(long long durNs);
+
+    // Histogram bucket of `us` (exposed for the exporter/bench)
+    static unsigned bucketOf(std::uint64_t us) noexcept;
+
+    // Smallest value that lands in `bucket`
+    static std::uint64_t bucketFloor(unsigned bucket) noexcept;
+
+    // Merge all shards and write the Prometheus exposition text
+    static void writePrometheus(std::ostream& out);
+};
@@ -1,26 +1,47 @@
 // core/Page.cpp
 #include "core/Page.hpp"
+#include "core/Metrics.hpp"
+#include "core/SchemaCheck.hpp"
+#include "core/Trace.hpp"
 #include "utils/utils.hpp"
 #include <iostream>
 #include <cstdlib>
 #include <cstring>
 #include <string>
 
-Page::Page(Database& db, Session& session)
-    : db_(db), session_(session) {
+Page::Page(RequestContext& ctx)
+    : ctx_(ctx), db_(ctx.db()), session_(ctx.session()),
+      postData_(ctx.arena()), requestTime_(ctx.now()) {
 }
 
 // -------------------------------------------------------------
 // Entry point dispatcher
 // -------------------------------------------------------------
 int Page::run() {
-    const char* method = std::getenv("REQUEST_METHOD");
-    if (method && std::string(method) == "POST") {
-        parsePost();
-        handlePost();
-    } else {
-        handleGet();
+    // Buffers the response only when tracing is on, so the
+    // Server-Timing header can include the render phase
+    Trace::Capture capture;
+    {
+        Trace::Span span("render");
+        const char* method = std::getenv("REQUEST_METHOD");
+        SchemaCheck::check(db_, requestTime_);
+        if (method && std::string(method) == "POST") {
+            if (!parsePost()) {
+                std::cout << "Status: 413 Payload Too Large\r\n"
+                          << "Content-Type: text/plain\r\n\r\n"
+                          << "Request body too large.\n";
+            } else {
+                handlePost();
+            }
+        } else {
+            handleGet();
+        }
     }
+    std::cout.flush();
+    ctx_.report();
+
+    const char* script = std::getenv("SCRIPT_NAME");
+    Metrics::observeRequest(script ? script : "", Trace::sinceStartNs());
     return 0;
 }
 
@@ -28,17 +49,29 @@ int Page::run() {
 // Sends required CGI header
 // -------------------------------------------------------------
 void Page::sendHTMLHeader() const {
+    sendPositionCookie();
     std::cout << "Content-Type: text/html\r\n\r\n";
 }
 
+// -------------------------------------------------------------
+// Read-your-writes cookie (see Database::connection)
+// -------------------------------------------------------------
+void Page::sendPositionCookie() const {
+    const std::string& position = db_.writePosition();
+    if (position.empty())
+        return;
+    std::cout << "Set-Cookie: " << Database::kPositionCookie << "=" << position
+              << "; Path=/; Max-Age=" << Database::kPositionCookieMaxAge
+              << "; HttpOnly; SameSite=Lax\r\n";
+}
+
 // -------------------------------------------------------------
 // Shared HTML head and navigation
 // mode: "auth" for login/register/logout (centered card)
 //       anything else for content pages (container layout)
 // -------------------------------------------------------------
 void Page::printHead(const std::string& title, const std::string& mode) const {
-    bool isLoggedIn = session_.isLoggedIn();
-    std::string email = isLoggedIn ? session_.userEmail() : "";
+    bool isLoggedIn = ctx_.loggedIn();
 
     std::cout
         << "<!doctype html>\n"
@@ -46,7 +79,6 @@ void Page::printHead(const std::string& title, const std::string& mode) const {
         << "<head>\n"
         << "  <meta charset='utf-8'>\n"
         << "  <meta name='viewport' content='width=device-width, initial-scale=1'>\n"
-        << "  <meta http-equiv='refresh' content='305'>\n"
         << "  <title>" << htmlEscape(title) << "</title>\n"
         << "  <link rel='stylesheet' href='../css/main.css'>\n"
         << "</head>\n"
@@ -113,8 +145,85 @@ void Page::printTail(const std::string& mode) const {
 }
 
 // -------------------------------------------------------------
-// Parse POST
+// Load-shedding response (429/503 + Retry-After)
+// -------------------------------------------------------------
+void Page::sendRetryLater(const char* status, unsigned retryAfterSeconds,
+    const std::string& message, const std::string& mode) const {
+    std::cout << "Status: " << status << "\r\n"
+              << "Retry-After: " << retryAfterSeconds << "\r\n"
+              << "Cache-Control: no-store\r\n"
+              << "Content-Type: text/html\r\n\r\n";
+
+    printHead("Please try again · Team Elevate", mode);
+    std::cout
+        << "    <section class='card' role='alert'>\n"
+        << "      <h2>Please try again shortly</h2>\n"
+        << "      <div class='error'>" << htmlEscape(message) << "</div>\n"
+        << "    </section>\n";
+    printTail(mode);
+}
+
+// -------------------------------------------------------------
+// Countdown ticker (formats like "2d 03h" / "03:14:07" / "Ended")
+// -------------------------------------------------------------
+void Page::printCountdownScript() const {
+    std::cout
+        << "<script>\n"
+        << "(function () {\n"
+        << "  function pad(n) { return (n < 10 ? '0' : '') + n; }\n"
+        << "  function fmt(s) {\n"
+        << "    if (s <= 0) return 'Ended';\n"
+        << "    var d = Math.floor(s / 86400), h = Math.floor(s % 86400 / 3600);\n"
+        << "    if (d > 0) return d + 'd ' + pad(h) + 'h';\n"
+        << "    return pad(h) + ':' + pad(Math.floor(s % 3600 / 60)) + ':' + pad(s % 60);\n"
+        << "  }\n"
+        << "  function tick() {\n"
+        << "    var now = Math.floor(Date.now() / 1000);\n"
+        << "    document.querySelectorAll('time.countdown[data-end]').forEach(function (t) {\n"
+        << "      t.textContent = fmt(Number(t.getAttribute('data-end')) - now);\n"
+        << "    });\n"
+        << "  }\n"
+        << "  tick();\n"
+        << "  setInterval(tick, 1000);\n"
+        << "})();\n"
+        << "</script>\n";
+}
+
+// -------------------------------------------------------------
+// Live prices: patch [data-item] elements from events.cgi
+// -------------------------------------------------------------
+void Page::printLiveScript() const {
+    std::cout
+        << "<script>\n"
+        << "(function () {\n"
+        << "  if (!window.EventSource) return;\n"
+        << "  var ids = {};\n"
+        << "  document.querySelectorAll('[data-item]').forEach(function (el) {\n"
+        << "    ids[el.getAttribute('data-item')] = 1;\n"
+        << "  });\n"
+        << "  var list = Object.keys(ids);\n"
+        << "  if (!list.length) return;\n"
+        << "  var src = new EventSource('events.cgi' + (list.length <= 500 ? '?items=' + list.join(',') : ''));\n"
+        << "  src.addEventListener('bid', function (e) {\n"
+        << "    var d = JSON.parse(e.data);\n"
+        << "    document.querySelectorAll('[data-item=\"' + d.item + '\"]').forEach(function (el) {\n"
+        << "      el.querySelectorAll('.js-price').forEach(function (p) { p.textContent = d.price; });\n"
+        << "      el.querySelectorAll('time.countdown').forEach(function (t) { t.setAttribute('data-end', d.end); });\n"
+        << "      el.querySelectorAll('.js-leader').forEach(function (l) {\n"
+        << "        l.textContent = d.you ? 'You are the highest bidder' : 'Current bid';\n"
+        << "      });\n"
+        << "      var input = el.querySelector('input[name=bid_amount]');\n"
+        << "      if (input) input.min = (Number(d.price) + 0.01).toFixed(2);\n"
+        << "    });\n"
+        << "  });\n"
+        << "  src.addEventListener('resync', function () { src.close(); location.reload(); });\n"
+        << "})();\n"
+        << "</script>\n";
+}
+
+// -------------------------------------------------------------
+// Parse POST (bounded by maxPostBytes)
 // -------------------------------------------------------------
-void Page::parsePost() {
-    postData_ = parsePostData();
+bool Page::parsePost() {
+    return parsePostData(postData_, maxPostBytes()) != PostStatus::TooLarge;
 }
@@ -1,20 +1,31 @@
 // core/Page.hpp
 #pragma once
 
+#include <cstddef>
+#include <ctime>
 #include <string>
-#include <map>
 #include <mysql/mysql.h>
 #include "core/Database.hpp"
 #include "core/Session.hpp"
+#include "core/RequestContext.hpp"
+#include "utils/FormData.hpp"
 
 class Page {
 protected:
+    // Request-scoped state: arena, memoized lookups, accounting
+    RequestContext& ctx_;
     Database& db_;
     Session& session_;
-    std::map<std::string, std::string> postData_;
+
+    // Decoded into the request arena
+    FormData postData_;
+
+    // Sampled once per request (ctx_.now()); every server-side time
+    // comparison binds this instead of calling NOW() or std::time().
+    const std::time_t requestTime_;
 
 public:
-    Page(Database& db, Session& session);
+    explicit Page(RequestContext& ctx);
     virtual ~Page() = default;
 
     int run();
@@ -23,9 +34,36 @@ protected:
     virtual void handleGet() = 0;
     virtual void handlePost() {}
 
+    std::pmr::memory_resource* arena() noexcept { return ctx_.arena(); }
+
     void sendHTMLHeader() const;
+
+    // Set-Cookie line carrying Database::writePosition() after this
+    // request wrote, so the user's next reads see the write even
+    // on a replica; nothing otherwise. Part of sendHTMLHeader();
+    // pages writing their own headers call it before the blank line.
+    void sendPositionCookie() const;
     void printHead(const std::string& title, const std::string& mode = "") const;
     void printTail(const std::string& mode = "") const;
 
-    void parsePost();
+    // Complete response for shed load: `status` (e.g. "503 Service
+    // Unavailable"), a Retry-After header and a short message card.
+    void sendRetryLater(const char* status, unsigned retryAfterSeconds,
+        const std::string& message, const std::string& mode = "") const;
+
+    // Client-side ticker for <time class='countdown' data-end='EPOCH'>
+    // elements, so rendered rows never carry a server-computed
+    // "time left" and stay identical across users and over time.
+    void printCountdownScript() const;
+
+    // Subscribes to events.cgi for every [data-item='ID'] element
+    // and patches its .js-price, .js-leader and countdown in place,
+    // so live pages need no meta refresh.
+    void printLiveScript() const;
+
+    // Largest POST body this page accepts; bigger requests get a
+    // 413 before any of the body is read.
+    virtual std::size_t maxPostBytes() const { return 8 * 1024; }
+
+    bool parsePost();
 };
@@ -0,0 +1,106 @@
+// core/RateSketch.cpp
+#include "core/RateSketch.hpp"
+#include <atomic>
+#include <limits>
+
+RateSketch::RateSketch(std::string_view name, unsigned windowSeconds)
+    : segment_(name, sizeof(Layout)),
+      data_(segment_.as<Layout>()),
+      window_(windowSeconds ? windowSeconds : 1) {
+}
+
+// -------------------------------------------------------------
+// Column per row from one 64-bit FNV-1a hash (double hashing)
+// -------------------------------------------------------------
+RateSketch::Slots RateSketch::slotsFor(std::string_view key) noexcept {
+    std::uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    const std::uint32_t h1 = static_cast<std::uint32_t>(h);
+    const std::uint32_t h2 = static_cast<std::uint32_t>(h >> 32) | 1u;
+
+    Slots s{};
+    for (unsigned row = 0; row < kDepth; ++row)
+        s.col[row] = (h1 + row * h2) % kWidth;
+    return s;
+}
+
+// Periods are numbered from 1 so an all-zero segment holds none
+std::uint64_t RateSketch::periodOf(std::time_t now) const noexcept {
+    return static_cast<std::uint64_t>(now) / window_ + 1;
+}
+
+// -------------------------------------------------------------
+// Half that holds `period`, claiming and clearing it if it still
+// holds an older one. Increments racing with the clear may be
+// lost; for throttling that only errs towards admitting.
+// -------------------------------------------------------------
+unsigned RateSketch::currentHalf(std::uint64_t period) {
+    const unsigned half = static_cast<unsigned>(period & 1);
+    std::atomic_ref<std::uint64_t> held(data_->period[half]);
+
+    std::uint64_t seen = held.load(std::memory_order_acquire);
+    if (seen < period &&
+        held.compare_exchange_strong(seen, period, std::memory_order_acq_rel)) {
+        for (auto& row : data_->counts[half])
+            for (auto& c : row)
+                std::atomic_ref<std::uint32_t>(c).store(0, std::memory_order_relaxed);
+    }
+    return half;
+}
+
+// -------------------------------------------------------------
+// min over rows of (current + weighted previous)
+// -------------------------------------------------------------
+unsigned RateSketch::combine(const Slots& s, std::uint64_t period, std::time_t now) const {
+    const unsigned cur = static_cast<unsigned>(period & 1);
+    const unsigned prev = cur ^ 1u;
+
+    const bool curValid =
+        std::atomic_ref<std::uint64_t>(data_->period[cur]).load(std::memory_order_acquire) == period;
+    const bool prevValid =
+        std::atomic_ref<std::uint64_t>(data_->period[prev]).load(std::memory_order_acquire) == period - 1;
+
+    // Share of the previous period still inside the window
+    const std::uint64_t elapsed = static_cast<std::uint64_t>(now) % window_;
+    const std::uint64_t weight = window_ - elapsed;
+
+    std::uint64_t best = std::numeric_limits<std::uint64_t>::max();
+    for (unsigned row = 0; row < kDepth; ++row) {
+        std::uint64_t c = curValid
+            ? std::atomic_ref<std::uint32_t>(data_->counts[cur][row][s.col[row]]).load(std::memory_order_relaxed)
+            : 0;
+        std::uint64_t p = prevValid
+            ? std::atomic_ref<std::uint32_t>(data_->counts[prev][row][s.col[row]]).load(std::memory_order_relaxed)
+            : 0;
+        std::uint64_t v = c + (p * weight) / window_;
+        if (v < best) best = v;
+    }
+    return best > std::numeric_limits<unsigned>::max()
+        ? std::numeric_limits<unsigned>::max() : static_cast<unsigned>(best);
+}
+
+unsigned RateSketch::hit(std::string_view key, std::time_t now) {
+    if (!data_) return 0;
+
+    const std::uint64_t period = periodOf(now);
+    const unsigned half = currentHalf(period);
+    const Slots s = slotsFor(key);
+
+    for (unsigned row = 0; row < kDepth; ++row)
+        std::atomic_ref<std::uint32_t>(data_->counts[half][row][s.col[row]])
+            .fetch_add(1, std::memory_order_relaxed);
+
+    return combine(s, period, now);
+}
+
+unsigned RateSketch::estimate(std::string_view key, std::time_t now) const {
+    if (!data_) return 0;
+    return combine(slotsFor(key), periodOf(now), now);
+}
+
+unsigned RateSketch::secondsUntilDecay(std::time_t now) const noexcept {
+    return window_ - static_cast<unsigned>(static_cast<std::uint64_t>(now) % window_);
+}
@@ -0,0 +1,63 @@
+// core/RateSketch.hpp
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+#include "core/SharedSegment.hpp"
+
+// =============================================================
+// RateSketch — Team Elevate Auctions
+// Approximate per-key event counts over a sliding window,
+// shared across CGI processes. Counts live in a count-min sketch
+// (kDepth rows x kWidth 32-bit counters) in a SharedSegment, so
+// memory is fixed (~128 KiB) however many keys are seen, and
+// estimates can only over-count.
+//
+// The window slides by keeping two sketches, one per fixed
+// period of `windowSeconds`: the estimate is the current
+// period's count plus the previous period's count weighted by
+// how much of it still overlaps the window.
+//
+// When the segment is unavailable every estimate is 0 (fail
+// open), so a broken /dev/shm cannot lock users out.
+// =============================================================
+class RateSketch {
+public:
+    static constexpr unsigned kDepth = 4;
+    static constexpr unsigned kWidth = 4096;
+
+    RateSketch(std::string_view name, unsigned windowSeconds);
+
+    bool ok() const noexcept { return data_ != nullptr; }
+
+    // Record one event for `key` and return the estimated number
+    // of events in the last window, this one included.
+    unsigned hit(std::string_view key, std::time_t now);
+
+    // Estimated events in the last window, without recording one.
+    unsigned estimate(std::string_view key, std::time_t now) const;
+
+    // Seconds until the current period rotates out of full weight;
+    // a reasonable Retry-After for a rejected key.
+    unsigned secondsUntilDecay(std::time_t now) const noexcept;
+
+private:
+    struct Layout {
+        std::uint64_t period[2];                        // period held by each half (0 = unused)
+        std::uint32_t counts[2][kDepth][kWidth];
+    };
+
+    SharedSegment segment_;
+    Layout* data_;
+    unsigned window_;
+
+    struct Slots {
+        std::uint32_t col[kDepth];
+    };
+    static Slots slotsFor(std::string_view key) noexcept;
+
+    std::uint64_t periodOf(std::time_t now) const noexcept;
+    unsigned currentHalf(std::uint64_t period);
+    unsigned combine(const Slots& s, std::uint64_t period, std::time_t now) const;
+};
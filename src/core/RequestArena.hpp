@@ -0,0 +1,32 @@
+// core/RequestArena.hpp
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+// =============================================================
+// RequestArena — Team Elevate Auctions
+// Monotonic std::pmr arena that lives exactly as long as one
+// request. The first 64 KiB come from an inline buffer, so a
+// typical page never calls malloc for its form data, SQL text
+// or row buffers; anything beyond that is taken from the heap
+// in growing blocks. Nothing is freed individually — the whole
+// arena is released when the owning RequestContext is destroyed.
+// =============================================================
+class RequestArena {
+public:
+    static constexpr std::size_t kInlineBytes = 64 * 1024;
+
+    RequestArena()
+        : resource_(inline_, sizeof(inline_), std::pmr::new_delete_resource()) {
+    }
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept { return &resource_; }
+
+private:
+    alignas(std::max_align_t) std::byte inline_[kInlineBytes];
+    std::pmr::monotonic_buffer_resource resource_;
+};
@@ -0,0 +1,306 @@
+// core/RequestContext.cpp
+#include "core/RequestContext.hpp"
+#include "core/Statement.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+
+static std::timespec monotonicNow() {
+    std::timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts;
+}
+
+RequestContext::RequestContext(Database& db, Session& session)
+    : db_(db), session_(session),
+      now_(std::time(nullptr)), started_(monotonicNow()),
+      states_(arena_.resource()), activeItems_(arena_.resource()),
+      snapshot_(arena_.resource()) {
+}
+
+// -------------------------------------------------------------
+// Shared active-items snapshot (loaded at most once)
+// -------------------------------------------------------------
+const std::pmr::vector<ActiveItemsCache::Item>* RequestContext::activeSnapshot() {
+    if (snapshotState_ == 0)
+        snapshotState_ = ActiveItemsCache::load(db_, now_, arena(), snapshot_) ? 1 : -1;
+    return snapshotState_ > 0 ? &snapshot_ : nullptr;
+}
+
+const char* const RequestContext::kItemStateSql =
+    "SELECT i.seller_id, CAST(ROUND(i.start_price*100) AS SIGNED) AS start_cents, "
+    "       CAST(ROUND(IFNULL((SELECT MAX(b.bid_amount) FROM bids b WHERE b.item_id=i.item_id), 0)*100) AS SIGNED) AS max_cents, "
+    "       (FROM_UNIXTIME(?) BETWEEN i.start_time AND i.end_time) AS is_active, "
+    "       UNIX_TIMESTAMP(i.end_time), i.title, i.description, u.user_email "
+    "FROM items i JOIN users u ON u.user_id = i.seller_id "
+    "WHERE i.item_id=? LIMIT 1";
+
+// -------------------------------------------------------------
+// Item state: seller, start price, current max bid, active flag
+// -------------------------------------------------------------
+const RequestContext::ItemState* RequestContext::itemState(long itemId) {
+    for (const auto& m : states_) {
+        if (m.itemId == itemId)
+            return m.found ? &m.state : nullptr;
+    }
+
+    const char* sql = kItemStateSql;
+
+    long long now = static_cast<long long>(now_);
+    MYSQL_BIND p[2]; std::memset(p, 0, sizeof(p));
+    p[0].buffer_type = MYSQL_TYPE_LONGLONG; p[0].buffer = &now;
+    p[1].buffer_type = MYSQL_TYPE_LONG; p[1].buffer = &itemId; p[1].is_unsigned = 1;
+
+    long seller = 0; long long startCents = 0, maxCents = 0, endEpoch = 0; int active = 0;
+    char titleBuf[256]; unsigned long titleLen = 0;
+    char descBuf[2048]; unsigned long descLen = 0; my_bool descNull = 0;
+    char emailBuf[129]; unsigned long emailLen = 0;
+
+    MYSQL_BIND r[8]; std::memset(r, 0, sizeof(r));
+    r[0].buffer_type = MYSQL_TYPE_LONG;     r[0].buffer = &seller; r[0].is_unsigned = 1;
+    r[1].buffer_type = MYSQL_TYPE_LONGLONG; r[1].buffer = &startCents;
+    r[2].buffer_type = MYSQL_TYPE_LONGLONG; r[2].buffer = &maxCents;
+    r[3].buffer_type = MYSQL_TYPE_LONG;     r[3].buffer = &active;
+    r[4].buffer_type = MYSQL_TYPE_LONGLONG; r[4].buffer = &endEpoch;
+    r[5].buffer_type = MYSQL_TYPE_STRING;   r[5].buffer = titleBuf; r[5].buffer_length = sizeof(titleBuf); r[5].length = &titleLen;
+    r[6].buffer_type = MYSQL_TYPE_STRING;   r[6].buffer = descBuf;  r[6].buffer_length = sizeof(descBuf);  r[6].length = &descLen; r[6].is_null = &descNull;
+    r[7].buffer_type = MYSQL_TYPE_STRING;   r[7].buffer = emailBuf; r[7].buffer_length = sizeof(emailBuf); r[7].length = &emailLen;
+
+    Statement stmt(db_, sql);
+    bool found = stmt.bindParams(p) && stmt.execute() &&
+                 stmt.bindResult(r) && stmt.fetch();
+
+    StateMemo& m = states_.emplace_back(StateMemo{ itemId, found, ItemState{
+        itemId, 0, Money(), Money(), false, 0,
+        std::pmr::string(arena()), std::pmr::string(arena()), std::pmr::string(arena()) } });
+    if (!found)
+        return nullptr;
+
+    ItemState& st = m.state;
+    st.sellerId = seller;
+    st.startPrice = Money::fromCents(startCents);
+    st.currentMaxBid = Money::fromCents(maxCents);
+    st.active = (active != 0);
+    st.endEpoch = static_cast<std::time_t>(endEpoch);
+    st.title.assign(titleBuf, titleLen < sizeof(titleBuf) ? titleLen : sizeof(titleBuf));
+    st.sellerEmail.assign(emailBuf, emailLen < sizeof(emailBuf) ? emailLen : sizeof(emailBuf));
+
+    // Long descriptions: fetch the rest of the column on demand
+    if (!descNull) {
+        if (descLen <= sizeof(descBuf)) {
+            st.description.assign(descBuf, descLen);
+        } else {
+            st.description.resize(descLen);
+            MYSQL_BIND col; std::memset(&col, 0, sizeof(col));
+            col.buffer_type = MYSQL_TYPE_STRING;
+            col.buffer = st.description.data();
+            col.buffer_length = descLen;
+            if (mysql_stmt_fetch_column(stmt.handle(), &col, 6, 0) != 0)
+                st.description.assign(descBuf, sizeof(descBuf));
+        }
+    }
+    return &st;
+}
+
+void RequestContext::forgetItem(long itemId) {
+    for (auto& m : states_) {
+        if (m.itemId == itemId)
+            m.itemId = 0;   // ids start at 1, so 0 never matches
+    }
+}
+
+const char* const RequestContext::kActiveItemsSql =
+    "SELECT i.item_id, i.title "
+    "FROM items i "
+    "WHERE i.start_time <= FROM_UNIXTIME(?) "
+    "  AND i.end_time > FROM_UNIXTIME(?) "
+    "  AND (? <= 0 OR i.seller_id <> ?) "
+    "ORDER BY i.end_time ASC, i.title ASC";
+
+// -------------------------------------------------------------
+// Active items, excluding one seller's own listings
+// -------------------------------------------------------------
+const std::pmr::vector<RequestContext::ItemOption>&
+RequestContext::activeItems(long excludeSellerId) {
+    if (excludeSellerId == activeExclude_)
+        return activeItems_;
+
+    activeExclude_ = excludeSellerId;
+    activeItems_.clear();
+
+    if (const auto* snap = activeSnapshot()) {
+        for (const auto& it : *snap) {
+            if (it.startEpoch > now_) continue;
+            if (excludeSellerId > 0 && it.sellerId == excludeSellerId) continue;
+            activeItems_.push_back(ItemOption{ it.id, std::pmr::string(it.title, arena()) });
+        }
+        return activeItems_;
+    }
+
+    const char* sql = kActiveItemsSql;
+
+    MYSQL_BIND p[4]; std::memset(p, 0, sizeof(p));
+    long long now = static_cast<long long>(now_);
+    long ex = excludeSellerId;
+    p[0].buffer_type = MYSQL_TYPE_LONGLONG; p[0].buffer = &now;
+    p[1].buffer_type = MYSQL_TYPE_LONGLONG; p[1].buffer = &now;
+    p[2].buffer_type = MYSQL_TYPE_LONG; p[2].buffer = &ex;
+    p[3].buffer_type = MYSQL_TYPE_LONG; p[3].buffer = &ex;
+
+    long idBuf = 0;
+    char titleBuf[256]{};
+    unsigned long titleLen = 0;
+
+    MYSQL_BIND r[2]; std::memset(r, 0, sizeof(r));
+    r[0].buffer_type = MYSQL_TYPE_LONG;   r[0].buffer = &idBuf;   r[0].is_unsigned = 1;
+    r[1].buffer_type = MYSQL_TYPE_STRING; r[1].buffer = titleBuf; r[1].buffer_length = sizeof(titleBuf); r[1].length = &titleLen;
+
+    Statement stmt(db_, sql, Database::Route::Replica);
+    if (!stmt.bindParams(p) || !stmt.execute(Statement::Fetch::Streaming) || !stmt.bindResult(r))
+        return activeItems_;
+
+    while (stmt.fetch()) {
+        std::size_t len = titleLen < sizeof(titleBuf) ? titleLen : sizeof(titleBuf);
+        activeItems_.push_back(ItemOption{ idBuf, std::pmr::string(titleBuf, len, arena()) });
+    }
+    // A list cut off mid-stream would silently hide items
+    if (stmt.failed())
+        activeItems_.clear();
+    return activeItems_;
+}
+
+const char* const RequestContext::kActiveItemsCountSql =
+    "SELECT COUNT(*) "
+    "FROM items i "
+    "WHERE i.start_time <= FROM_UNIXTIME(?) "
+    "  AND i.end_time > FROM_UNIXTIME(?) "
+    "  AND (? <= 0 OR i.seller_id <> ?) "
+    "  AND i.title LIKE ?";
+
+const char* const RequestContext::kActiveItemsPageSql =
+    "SELECT i.item_id, i.title "
+    "FROM items i "
+    "WHERE i.start_time <= FROM_UNIXTIME(?) "
+    "  AND i.end_time > FROM_UNIXTIME(?) "
+    "  AND (? <= 0 OR i.seller_id <> ?) "
+    "  AND i.title LIKE ? "
+    "ORDER BY i.end_time ASC, i.title ASC "
+    "LIMIT ? OFFSET ?";
+
+// -------------------------------------------------------------
+// One page of active items matching a title search
+// -------------------------------------------------------------
+std::size_t RequestContext::activeItemsPage(long excludeSellerId, std::string_view search,
+    std::size_t& page, std::size_t pageSize, std::pmr::vector<ItemOption>& out) {
+    out.clear();
+    if (pageSize == 0) pageSize = 1;
+
+    if (activeSnapshot()) {
+        const auto& all = activeItems(excludeSellerId);
+        auto matches = [&](const ItemOption& it) {
+            if (search.empty()) return true;
+            auto hit = std::search(it.title.begin(), it.title.end(), search.begin(), search.end(),
+                [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) ==
+                           std::tolower(static_cast<unsigned char>(b));
+                });
+            return hit != it.title.end();
+        };
+
+        const std::size_t total = static_cast<std::size_t>(std::count_if(all.begin(), all.end(), matches));
+        const std::size_t pages = total ? (total + pageSize - 1) / pageSize : 1;
+        page = std::min(page, pages - 1);
+
+        const std::size_t first = page * pageSize;
+        std::size_t seen = 0;
+        for (const auto& it : all) {
+            if (!matches(it)) continue;
+            if (seen >= first && seen < first + pageSize)
+                out.push_back(ItemOption{ it.id, std::pmr::string(it.title, arena()) });
+            ++seen;
+        }
+        return total;
+    }
+
+    // Substring match: escape LIKE's own wildcards in the term
+    std::pmr::string pattern(arena());
+    pattern += '%';
+    for (char c : search) {
+        if (c == '%' || c == '_' || c == '\\') pattern += '\\';
+        pattern += c;
+    }
+    pattern += '%';
+
+    long long now = static_cast<long long>(now_);
+    long ex = excludeSellerId;
+    unsigned long patternLen = pattern.size();
+    MYSQL_BIND p[7]; std::memset(p, 0, sizeof(p));
+    p[0].buffer_type = MYSQL_TYPE_LONGLONG; p[0].buffer = &now;
+    p[1].buffer_type = MYSQL_TYPE_LONGLONG; p[1].buffer = &now;
+    p[2].buffer_type = MYSQL_TYPE_LONG;     p[2].buffer = &ex;
+    p[3].buffer_type = MYSQL_TYPE_LONG;     p[3].buffer = &ex;
+    p[4].buffer_type = MYSQL_TYPE_STRING;   p[4].buffer = pattern.data();
+    p[4].buffer_length = patternLen;        p[4].length = &patternLen;
+
+    long long total = 0;
+    {
+        MYSQL_BIND r[1]; std::memset(r, 0, sizeof(r));
+        r[0].buffer_type = MYSQL_TYPE_LONGLONG; r[0].buffer = &total;
+
+        Statement stmt(db_, kActiveItemsCountSql, Database::Route::Replica);
+        if (!stmt.bindParams(p) || !stmt.execute() || !stmt.bindResult(r) || !stmt.fetch())
+            return 0;
+    }
+
+    const std::size_t count = total > 0 ? static_cast<std::size_t>(total) : 0;
+    const std::size_t pages = count ? (count + pageSize - 1) / pageSize : 1;
+    page = std::min(page, pages - 1);
+    if (count == 0)
+        return 0;
+
+    long long limit = static_cast<long long>(pageSize);
+    long long offset = static_cast<long long>(page * pageSize);
+    p[5].buffer_type = MYSQL_TYPE_LONGLONG; p[5].buffer = &limit;
+    p[6].buffer_type = MYSQL_TYPE_LONGLONG; p[6].buffer = &offset;
+
+    long idBuf = 0;
+    char titleBuf[256]{};
+    unsigned long titleLen = 0;
+
+    MYSQL_BIND r[2]; std::memset(r, 0, sizeof(r));
+    r[0].buffer_type = MYSQL_TYPE_LONG;   r[0].buffer = &idBuf;   r[0].is_unsigned = 1;
+    r[1].buffer_type = MYSQL_TYPE_STRING; r[1].buffer = titleBuf; r[1].buffer_length = sizeof(titleBuf); r[1].length = &titleLen;
+
+    Statement stmt(db_, kActiveItemsPageSql, Database::Route::Replica);
+    if (!stmt.bindParams(p) || !stmt.execute() || !stmt.bindResult(r))
+        return count;
+
+    while (stmt.fetch()) {
+        std::size_t len = titleLen < sizeof(titleBuf) ? titleLen : sizeof(titleBuf);
+        out.push_back(ItemOption{ idBuf, std::pmr::string(titleBuf, len, arena()) });
+    }
+    if (stmt.failed())
+        out.clear();
+    return count;
+}
+
+// -------------------------------------------------------------
+// Per-request accounting line (stderr → server error log)
+// -------------------------------------------------------------
+void RequestContext::report() const {
+    if (!std::getenv("AUCTION_REQUEST_STATS"))
+        return;
+
+    std::timespec end = monotonicNow();
+    long usec = (end.tv_sec - started_.tv_sec) * 1000000L +
+                (end.tv_nsec - started_.tv_nsec) / 1000L;
+
+    const char* page = std::getenv("SCRIPT_NAME");
+    const QueryStats& s = db_.stats();
+    std::fprintf(stderr,
+        "request page=%s statements=%u round_trips=%u rows=%u elapsed_us=%ld\n",
+        page ? page : "-", s.statements, s.roundTrips, s.rows, usec);
+}
@@ -0,0 +1,130 @@
+// core/RequestContext.hpp
+#pragma once
+
+#include <ctime>
+#include <deque>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/ActiveItemsCache.hpp"
+#include "core/Database.hpp"
+#include "core/Session.hpp"
+#include "core/RequestArena.hpp"
+#include "utils/Money.hpp"
+
+// =============================================================
+// RequestContext — Team Elevate Auctions
+// Everything that lives exactly as long as one CGI request:
+// the arena, the sampled request time, and memoized answers to
+// the questions pages ask more than once (who is logged in,
+// what state an item is in, which items are biddable). Each
+// lookup hits the database at most once per request; the
+// connection's QueryStats record what was actually sent.
+// =============================================================
+class RequestContext {
+public:
+    // Biddable item as listed in the Bid page dropdown
+    struct ItemOption {
+        long id;
+        std::pmr::string title;
+    };
+
+    // One item's listing details, prices and active flag
+    // (strings live in the request arena)
+    struct ItemState {
+        long itemId;
+        long sellerId;
+        Money startPrice;
+        Money currentMaxBid;
+        bool active;
+        std::time_t endEpoch;
+        std::pmr::string title;
+        std::pmr::string description;
+        std::pmr::string sellerEmail;
+    };
+
+    RequestContext(Database& db, Session& session);
+
+    RequestContext(const RequestContext&) = delete;
+    RequestContext& operator=(const RequestContext&) = delete;
+
+    Database& db() noexcept { return db_; }
+    Session& session() noexcept { return session_; }
+    std::pmr::memory_resource* arena() noexcept { return arena_.resource(); }
+    std::time_t now() const noexcept { return now_; }
+
+    // ---------------------------------------------------------
+    // Identity (Session::validate() runs once per request)
+    // ---------------------------------------------------------
+    bool loggedIn() { return session_.validate(); }
+    long userId() { return loggedIn() ? session_.userId() : 0; }
+    const std::string& userEmail() { loggedIn(); return session_.userEmail(); }
+
+    // ---------------------------------------------------------
+    // Item lookups
+    // ---------------------------------------------------------
+
+    // State of `itemId` (one primary-key lookup), or nullptr when
+    // it does not exist. Misses are memoized too. The pointer stays
+    // valid for the whole request, across later lookups.
+    const ItemState* itemState(long itemId);
+
+    // Drop the memoized state after this request changed the item.
+    void forgetItem(long itemId);
+
+    // Items open for bidding at now(), soonest-ending first,
+    // excluding those sold by `excludeSellerId` (0 = none).
+    // Served from the shared snapshot when available.
+    const std::pmr::vector<ItemOption>& activeItems(long excludeSellerId);
+
+    // One page of activeItems() whose title contains `search`
+    // (case-insensitive; empty matches all) into `out`; returns
+    // the number of matches, and clamps `page` to the last page.
+    // Filtered in memory when the shared snapshot is available;
+    // otherwise the filter, count and page window run in SQL, so
+    // a large catalog never comes into the request.
+    std::size_t activeItemsPage(long excludeSellerId, std::string_view search,
+        std::size_t& page, std::size_t pageSize, std::pmr::vector<ItemOption>& out);
+
+    // Every unexpired item from the shared ActiveItemsCache
+    // snapshot, or nullptr when callers must query directly.
+    const std::pmr::vector<ActiveItemsCache::Item>* activeSnapshot();
+
+    // ---------------------------------------------------------
+    // Accounting
+    // ---------------------------------------------------------
+    const QueryStats& stats() const noexcept { return db_.stats(); }
+
+    // One stderr line per request (page, statements, round trips,
+    // rows, elapsed) when AUCTION_REQUEST_STATS is set.
+    void report() const;
+
+    // Statements behind itemState() and activeItems()'s direct
+    // path, exposed for the plan regression tests (make plan-test)
+    static const char* const kItemStateSql;
+    static const char* const kActiveItemsSql;
+    static const char* const kActiveItemsCountSql;
+    static const char* const kActiveItemsPageSql;
+
+private:
+    // Declared first: the memo tables below draw from it
+    RequestArena arena_;
+    Database& db_;
+    Session& session_;
+    const std::time_t now_;
+    const std::timespec started_;
+
+    struct StateMemo {
+        long itemId;
+        bool found;
+        ItemState state;
+    };
+    std::pmr::deque<StateMemo> states_;   // deque: growth never moves entries
+
+    long activeExclude_ = -1;     // -1 = activeItems_ not loaded yet
+    std::pmr::vector<ItemOption> activeItems_;
+
+    int snapshotState_ = 0;       // 0 = not tried, 1 = loaded, -1 = unavailable
+    std::pmr::vector<ActiveItemsCache::Item> snapshot_;
+};
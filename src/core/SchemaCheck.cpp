@@ -0,0 +1,134 @@
+// core/SchemaCheck.cpp
+#include "core/SchemaCheck.hpp"
+#include "core/Metrics.hpp"
+#include "core/SharedSegment.hpp"
+#include "core/Statement.hpp"
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+const SchemaCheck::ExpectedIndex SchemaCheck::kExpected[] = {
+    { "sessions",           "idx_sessions_token",   "session_token" },
+    { "bids",               "idx_bids_item_amount", "item_id,bid_amount" },
+    { "bids",               "idx_bids_bidder_item", "bidder_id,item_id" },
+    { "items",              "idx_items_end",        "end_time" },
+    { "items",              "idx_items_seller_end", "seller_id,end_time" },
+    { "user_item_activity", "idx_uia_user_end",     "user_id,end_time,item_id" },
+};
+const unsigned SchemaCheck::kExpectedCount = sizeof(kExpected) / sizeof(kExpected[0]);
+
+namespace {
+
+enum Verdict : std::uint32_t { Unknown = 0, Ready = 1, Missing = 2 };
+
+struct Layout {
+    std::int64_t checkedAt;
+    std::uint32_t verdict;
+};
+
+const char* kSegmentName = "schema-check-v1";
+constexpr unsigned kMissingRecheckSeconds = 10;
+
+unsigned ttlSeconds() {
+    const char* v = std::getenv("AUCTION_SCHEMA_CHECK_TTL_S");
+    unsigned out = 600;
+    if (v && *v) {
+        const char* end = v + std::strlen(v);
+        auto [ptr, ec] = std::from_chars(v, end, out);
+        if (ec != std::errc() || ptr != end) out = 600;
+    }
+    return out;
+}
+
+// `columns` equals or starts `have` at a column boundary
+bool coversPrefix(std::string_view have, std::string_view want) {
+    return have.substr(0, want.size()) == want &&
+           (have.size() == want.size() || have[want.size()] == ',');
+}
+
+} // namespace
+
+// -------------------------------------------------------------
+// One information_schema scan: every index on the expected
+// tables with its columns in order
+// -------------------------------------------------------------
+bool SchemaCheck::findMissing(Database& db, std::vector<std::string>& missing) {
+    missing.clear();
+
+    const char* sql =
+        "SELECT TABLE_NAME, GROUP_CONCAT(COLUMN_NAME ORDER BY SEQ_IN_INDEX SEPARATOR ',') "
+        "FROM information_schema.STATISTICS "
+        "WHERE TABLE_SCHEMA = DATABASE() "
+        "AND TABLE_NAME IN ('sessions', 'bids', 'items', 'user_item_activity') "
+        "GROUP BY TABLE_NAME, INDEX_NAME";
+
+    char tableBuf[64];
+    char columnsBuf[512];
+    unsigned long tableLen = 0, columnsLen = 0;
+
+    MYSQL_BIND r[2];
+    std::memset(r, 0, sizeof(r));
+    r[0].buffer_type = MYSQL_TYPE_STRING; r[0].buffer = tableBuf;   r[0].buffer_length = sizeof(tableBuf);   r[0].length = &tableLen;
+    r[1].buffer_type = MYSQL_TYPE_STRING; r[1].buffer = columnsBuf; r[1].buffer_length = sizeof(columnsBuf); r[1].length = &columnsLen;
+
+    Statement stmt(db, sql);
+    if (!stmt.execute() || !stmt.bindResult(r))
+        return false;
+
+    bool found[sizeof(kExpected) / sizeof(kExpected[0])] = {};
+    while (stmt.fetch()) {
+        const std::string_view table(tableBuf, tableLen < sizeof(tableBuf) ? tableLen : sizeof(tableBuf));
+        const std::string_view columns(columnsBuf, columnsLen < sizeof(columnsBuf) ? columnsLen : sizeof(columnsBuf));
+        for (unsigned i = 0; i < kExpectedCount; ++i) {
+            if (!found[i] && table == kExpected[i].table && coversPrefix(columns, kExpected[i].columns))
+                found[i] = true;
+        }
+    }
+    if (stmt.failed())
+        return false;
+
+    for (unsigned i = 0; i < kExpectedCount; ++i) {
+        if (!found[i])
+            missing.push_back(std::string(kExpected[i].table) + "(" + kExpected[i].columns + ")");
+    }
+    return true;
+}
+
+// -------------------------------------------------------------
+// Shared verdict; concurrent re-checks are harmless (same answer)
+// -------------------------------------------------------------
+void SchemaCheck::check(Database& db, std::time_t now) {
+    const char* enabled = std::getenv("AUCTION_SCHEMA_CHECK");
+    if (enabled && std::strcmp(enabled, "0") == 0)
+        return;
+
+    // No shared verdict: every CGI process would scan
+    // information_schema, so leave it to migrate --verify
+    SharedSegment segment(kSegmentName, sizeof(Layout));
+    Layout* shm = segment.as<Layout>();
+    if (!shm)
+        return;
+
+    const std::int64_t checkedAt = std::atomic_ref<std::int64_t>(shm->checkedAt).load(std::memory_order_acquire);
+    const std::uint32_t verdict = std::atomic_ref<std::uint32_t>(shm->verdict).load(std::memory_order_acquire);
+    const unsigned ttl = verdict == Missing ? kMissingRecheckSeconds : ttlSeconds();
+    if (verdict != Unknown && now - checkedAt < static_cast<std::int64_t>(ttl))
+        return;
+
+    // A failed check query is cached as Ready, so it is retried
+    // once per TTL rather than on every request
+    std::vector<std::string> missing;
+    if (!findMissing(db, missing))
+        std::fprintf(stderr, "schema check: index query failed\n");
+    for (const std::string& m : missing)
+        std::fprintf(stderr, "schema check: missing index on %s (run migrate)\n", m.c_str());
+    if (!missing.empty())
+        Metrics::add(Metrics::SchemaIndexMissing, missing.size());
+
+    std::atomic_ref<std::uint32_t>(shm->verdict).store(missing.empty() ? Ready : Missing, std::memory_order_release);
+    std::atomic_ref<std::int64_t>(shm->checkedAt).store(static_cast<std::int64_t>(now), std::memory_order_release);
+}
@@ -0,0 +1,45 @@
+// core/SchemaCheck.hpp
+#pragma once
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include "core/Database.hpp"
+
+// =============================================================
+// SchemaCheck — Team Elevate Auctions
+// The indexes the hot queries cannot run without, and a check
+// that they exist. An index counts when its leading columns
+// match, whatever its name (a primary key on session_token
+// satisfies sessions(session_token)).
+//
+// The deploy-time gate is `migrate --verify`, which exits 1 when
+// an index is missing. Pages also call check() before
+// dispatching, as a warning that never refuses service: each
+// missing index is logged on stderr and counted in Metrics
+// (auction_schema_missing_indexes_total). The verdict is shared
+// host-wide in a SharedSegment and re-checked every
+// AUCTION_SCHEMA_CHECK_TTL_S (default 600 s; 10 s while an
+// index is missing, so a finished migration is noticed fast);
+// without the segment the page check is skipped rather than
+// run on every request. AUCTION_SCHEMA_CHECK=0 turns it off.
+// =============================================================
+class SchemaCheck {
+public:
+    struct ExpectedIndex {
+        const char* table;
+        const char* name;       // as created by sql/migrations
+        const char* columns;    // comma-separated, no spaces
+    };
+
+    static const ExpectedIndex kExpected[];
+    static const unsigned kExpectedCount;
+
+    // Fills `missing` with "table(columns)" for each absent index.
+    // False when the check query itself failed.
+    static bool findMissing(Database& db, std::vector<std::string>& missing);
+
+    // Re-check when the shared verdict is due; logs and counts
+    // missing indexes
+    static void check(Database& db, std::time_t now);
+};
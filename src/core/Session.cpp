@@ -1,14 +1,18 @@
 // core/Session.cpp
 #include "core/Session.hpp"
+#include "core/Statement.hpp"
+#include "core/Trace.hpp"
 #include "utils/utils.hpp"
 #include <cstdlib>
 #include <cstring>
 
 Session::Session(Database& db)
-    : db_(db), userId_(-1), loggedIn_(false) {
+    : db_(db), userId_(-1), loggedIn_(false), validated_(false) {
     token_ = readCookieToken();
     if (!token_.empty())
         loggedIn_ = validate();
+    else
+        validated_ = true;
 }
 
 // -------------------------------------------------------------
@@ -21,31 +25,26 @@ std::string Session::readCookieToken() const {
     return getCookieValue(std::string(cookieEnv), "session_token");
 }
 
+const char* const Session::kValidateSql =
+    "SELECT u.user_id, u.user_email "
+    "FROM sessions s JOIN users u ON s.user_id=u.user_id "
+    "WHERE s.session_token=? AND s.last_active > NOW() - INTERVAL 5 MINUTE "
+    "LIMIT 1";
+
 // -------------------------------------------------------------
 // Validate current session token (and refresh last_active)
 // -------------------------------------------------------------
 bool Session::validate() {
-    if (token_.empty())
-        return false;
+    if (validated_)
+        return loggedIn_;
+    validated_ = true;
 
-    MYSQL* conn = db_.connection();
-    if (!conn)
+    if (token_.empty())
         return false;
 
-    const char* sql =
-        "SELECT u.user_id, u.user_email "
-        "FROM sessions s JOIN users u ON s.user_id=u.user_id "
-        "WHERE s.session_token=? AND s.last_active > NOW() - INTERVAL 5 MINUTE "
-        "LIMIT 1";
-
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (!stmt)
-        return false;
+    Trace::Span span("session");
 
-    if (mysql_stmt_prepare(stmt, sql, std::strlen(sql)) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
+    const char* sql = kValidateSql;
 
     MYSQL_BIND param{};
     std::memset(&param, 0, sizeof(param));
@@ -53,9 +52,6 @@ bool Session::validate() {
     param.buffer = (char*)token_.c_str();
     param.buffer_length = token_.size();
 
-    mysql_stmt_bind_param(stmt, &param);
-    mysql_stmt_execute(stmt);
-
     MYSQL_BIND result[2];
     std::memset(result, 0, sizeof(result));
     long id = 0;
@@ -71,29 +67,25 @@ bool Session::validate() {
     result[1].buffer_length = sizeof(email);
     result[1].length = &len;
 
-    mysql_stmt_bind_result(stmt, result);
-    bool ok = (mysql_stmt_fetch(stmt) == 0);
-    mysql_stmt_close(stmt);
+    bool ok = false;
+    {
+        Statement stmt(db_, sql, Database::Route::Replica);
+        ok = stmt.bindParams(&param) &&
+             stmt.execute() &&
+             stmt.bindResult(result) &&
+             stmt.fetch();
+    }
 
     if (ok) {
         userId_ = id;
-        email_ = std::string(email, len);
+        email_ = std::string(email, len < sizeof(email) ? len : sizeof(email));
         loggedIn_ = true;
 
-        // Refresh last_active timestamp
+        // Refresh last_active timestamp (on the primary, but it
+        // does not pin this request's reads there)
         const char* updateSQL =
             "UPDATE sessions SET last_active=NOW() WHERE session_token=?";
-        MYSQL_STMT* upd = mysql_stmt_init(conn);
-        if (upd && mysql_stmt_prepare(upd, updateSQL, std::strlen(updateSQL)) == 0) {
-            MYSQL_BIND up{};
-            std::memset(&up, 0, sizeof(up));
-            up.buffer_type = MYSQL_TYPE_STRING;
-            up.buffer = (char*)token_.c_str();
-            up.buffer_length = token_.size();
-            mysql_stmt_bind_param(upd, &up);
-            mysql_stmt_execute(upd);
-            mysql_stmt_close(upd);
-        }
+        db_.execute(updateSQL, &param, 1, Database::Route::Housekeeping);
     }
     else {
         loggedIn_ = false;
@@ -109,38 +101,27 @@ void Session::create(long uid, const std::string& token, const std::string& ip)
     userId_ = uid;
     token_ = token;
     loggedIn_ = true;
-
-    MYSQL* conn = db_.connection();
-    if (!conn)
-        return;
+    validated_ = true;
 
     const char* sql =
         "INSERT INTO sessions (user_id, session_token, ip_address, last_active) "
         "VALUES (?, ?, ?, NOW())";
 
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (!stmt)
-        return;
-
-    if (mysql_stmt_prepare(stmt, sql, std::strlen(sql)) == 0) {
-        MYSQL_BIND params[3];
-        std::memset(params, 0, sizeof(params));
+    MYSQL_BIND params[3];
+    std::memset(params, 0, sizeof(params));
 
-        params[0].buffer_type = MYSQL_TYPE_LONG;
-        params[0].buffer = &userId_;
+    params[0].buffer_type = MYSQL_TYPE_LONG;
+    params[0].buffer = &userId_;
 
-        params[1].buffer_type = MYSQL_TYPE_STRING;
-        params[1].buffer = (char*)token_.c_str();
-        params[1].buffer_length = token_.size();
+    params[1].buffer_type = MYSQL_TYPE_STRING;
+    params[1].buffer = (char*)token_.c_str();
+    params[1].buffer_length = token_.size();
 
-        params[2].buffer_type = MYSQL_TYPE_STRING;
-        params[2].buffer = (char*)ip.c_str();
-        params[2].buffer_length = ip.size();
+    params[2].buffer_type = MYSQL_TYPE_STRING;
+    params[2].buffer = (char*)ip.c_str();
+    params[2].buffer_length = ip.size();
 
-        mysql_stmt_bind_param(stmt, params);
-        mysql_stmt_execute(stmt);
-    }
-    mysql_stmt_close(stmt);
+    db_.execute(sql, params, 3);
 }
 
 // -------------------------------------------------------------
@@ -150,23 +131,17 @@ void Session::destroy() {
     if (token_.empty())
         return;
 
-    MYSQL* conn = db_.connection();
-    if (!conn)
-        return;
-
     const char* sql = "DELETE FROM sessions WHERE session_token=?";
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (stmt && mysql_stmt_prepare(stmt, sql, std::strlen(sql)) == 0) {
-        MYSQL_BIND p{};
-        std::memset(&p, 0, sizeof(p));
-        p.buffer_type = MYSQL_TYPE_STRING;
-        p.buffer = (char*)token_.c_str();
-        p.buffer_length = token_.size();
-        mysql_stmt_bind_param(stmt, &p);
-        mysql_stmt_execute(stmt);
-        mysql_stmt_close(stmt);
-    }
+    MYSQL_BIND p{};
+    std::memset(&p, 0, sizeof(p));
+    p.buffer_type = MYSQL_TYPE_STRING;
+    p.buffer = (char*)token_.c_str();
+    p.buffer_length = token_.size();
+    db_.execute(sql, &p, 1);
 
     loggedIn_ = false;
+    validated_ = true;
+    userId_ = -1;
+    email_.clear();
     token_.clear();
 }
@@ -13,14 +13,27 @@ public:
 
     void create(long uid, const std::string& token, const std::string& ip);
     void destroy();
+
+    // Looks the token up (and refreshes last_active) on the first
+    // call only; later calls in the same request return the
+    // memoized result without touching the database.
     bool validate();
 
+    // Idle time after which validate() rejects a session; must
+    // match the INTERVAL in kValidateSql (tools/sweep_sessions
+    // deletes rows idle for longer)
+    static constexpr int kIdleTimeoutSeconds = 5 * 60;
+
+    // Token lookup run by validate() (checked by make plan-test)
+    static const char* const kValidateSql;
+
 private:
     Database& db_;
     std::string token_;
     std::string email_;
     long userId_;
     bool loggedIn_;
+    bool validated_;
 
     std::string readCookieToken() const;
 };
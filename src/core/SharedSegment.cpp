@@ -0,0 +1,38 @@
+// core/SharedSegment.cpp
+#include "core/SharedSegment.hpp"
+#include <cstdlib>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SharedSegment::SharedSegment(std::string_view name, std::size_t bytes) {
+    const char* dir = std::getenv("AUCTION_SHM_DIR");
+    std::string path = (dir && *dir) ? dir : "/dev/shm";
+    path += "/auction-";
+    path += name;
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) return;
+
+    // Grow (never shrink) to the requested size; concurrent
+    // creators race harmlessly since they ask for the same size.
+    struct stat st{};
+    if (fstat(fd, &st) != 0 ||
+        (static_cast<std::size_t>(st.st_size) < bytes && ftruncate(fd, static_cast<off_t>(bytes)) != 0)) {
+        close(fd);
+        return;
+    }
+
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);   // the mapping keeps the file referenced
+    if (p == MAP_FAILED) return;
+
+    base_ = p;
+    size_ = bytes;
+}
+
+SharedSegment::~SharedSegment() {
+    if (base_) munmap(base_, size_);
+}
@@ -0,0 +1,36 @@
+// core/SharedSegment.hpp
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// =============================================================
+// SharedSegment — Team Elevate Auctions
+// Fixed-size memory region shared by every CGI process on the
+// host: a file in AUCTION_SHM_DIR (default /dev/shm) mapped
+// MAP_SHARED. A new file is zero-filled by ftruncate(), so
+// layouts must treat all-zero bytes as a valid empty state.
+// Bump the name when a layout changes instead of migrating.
+//
+// Not finding or creating the file is not fatal: ok() is false
+// and callers fall back to their unshared behaviour.
+// =============================================================
+class SharedSegment {
+public:
+    SharedSegment(std::string_view name, std::size_t bytes);
+    ~SharedSegment();
+
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+
+    bool ok() const noexcept { return base_ != nullptr; }
+    void* data() const noexcept { return base_; }
+    std::size_t size() const noexcept { return size_; }
+
+    template <class T>
+    T* as() const noexcept { return size_ >= sizeof(T) ? static_cast<T*>(base_) : nullptr; }
+
+private:
+    void* base_ = nullptr;
+    std::size_t size_ = 0;
+};
@@ -0,0 +1,435 @@
+// core/SlowQueryLog.cpp
+#include "core/SlowQueryLog.hpp"
+#include "core/SharedSegment.hpp"
+#include "utils/JsonWriter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Fingerprint ids that already had their EXPLAIN captured
+struct Layout {
+    std::uint64_t ids[4096];
+};
+
+constexpr unsigned kProbe = 32;
+const char* kSegmentName = "slow-explain-v1";
+
+bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+// End of the quoted literal starting at `i` (one past the closing
+// quote); handles backslash escapes and doubled quotes
+std::size_t skipQuoted(std::string_view s, std::size_t i) {
+    const char q = s[i++];
+    while (i < s.size()) {
+        if (s[i] == '\\') { i += 2; continue; }
+        if (s[i] == q) {
+            if (i + 1 < s.size() && s[i + 1] == q) { i += 2; continue; }
+            return i + 1;
+        }
+        ++i;
+    }
+    return s.size();
+}
+
+// Leading keyword is one EXPLAIN accepts
+bool explainable(std::string_view sql) {
+    std::size_t i = 0;
+    while (i < sql.size() && (std::isspace(static_cast<unsigned char>(sql[i])) || sql[i] == '(')) ++i;
+    std::string word;
+    while (i < sql.size() && std::isalpha(static_cast<unsigned char>(sql[i])) && word.size() < 8)
+        word.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(sql[i++]))));
+    return word == "SELECT" || word == "UPDATE" || word == "DELETE" ||
+           word == "INSERT" || word == "REPLACE" || word == "WITH";
+}
+
+const char* typeName(enum_field_types t) {
+    switch (t) {
+    case MYSQL_TYPE_TINY:       return "tiny";
+    case MYSQL_TYPE_SHORT:      return "short";
+    case MYSQL_TYPE_LONG:       return "long";
+    case MYSQL_TYPE_LONGLONG:   return "longlong";
+    case MYSQL_TYPE_FLOAT:      return "float";
+    case MYSQL_TYPE_DOUBLE:     return "double";
+    case MYSQL_TYPE_STRING:
+    case MYSQL_TYPE_VAR_STRING: return "string";
+    case MYSQL_TYPE_BLOB:       return "blob";
+    case MYSQL_TYPE_DATE:       return "date";
+    case MYSQL_TYPE_TIME:       return "time";
+    case MYSQL_TYPE_DATETIME:   return "datetime";
+    case MYSQL_TYPE_TIMESTAMP:  return "timestamp";
+    case MYSQL_TYPE_NULL:       return "null";
+    default:                    return "other";
+    }
+}
+
+unsigned long bindLength(const MYSQL_BIND& b) {
+    return b.length ? *b.length : b.buffer_length;
+}
+
+bool bindIsNull(const MYSQL_BIND& b) {
+    return b.buffer_type == MYSQL_TYPE_NULL || (b.is_null && *b.is_null) || !b.buffer;
+}
+
+// Bytes of the value behind a non-null bind
+std::size_t valueBytes(const MYSQL_BIND& b) {
+    switch (b.buffer_type) {
+    case MYSQL_TYPE_TINY:       return 1;
+    case MYSQL_TYPE_SHORT:      return sizeof(short);
+    case MYSQL_TYPE_LONG:       return sizeof(int);
+    case MYSQL_TYPE_LONGLONG:   return sizeof(long long);
+    case MYSQL_TYPE_FLOAT:      return sizeof(float);
+    case MYSQL_TYPE_DOUBLE:     return sizeof(double);
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_TIME:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_TIMESTAMP:  return sizeof(MYSQL_TIME);
+    case MYSQL_TYPE_STRING:
+    case MYSQL_TYPE_VAR_STRING:
+    case MYSQL_TYPE_BLOB:       return bindLength(b);
+    default:                    return 0;
+    }
+}
+
+// One bound value as an SQL literal; false when the type is not handled
+bool appendLiteral(std::string& out, MYSQL* conn, const MYSQL_BIND& b) {
+    if (bindIsNull(b)) {
+        out += "NULL";
+        return true;
+    }
+    char buf[64];
+    int n = 0;
+    switch (b.buffer_type) {
+    case MYSQL_TYPE_TINY:
+        n = b.is_unsigned ? std::snprintf(buf, sizeof(buf), "%u", *static_cast<unsigned char*>(b.buffer))
+                          : std::snprintf(buf, sizeof(buf), "%d", *static_cast<signed char*>(b.buffer));
+        break;
+    case MYSQL_TYPE_SHORT:
+        n = b.is_unsigned ? std::snprintf(buf, sizeof(buf), "%u", *static_cast<unsigned short*>(b.buffer))
+                          : std::snprintf(buf, sizeof(buf), "%d", *static_cast<short*>(b.buffer));
+        break;
+    case MYSQL_TYPE_LONG:
+        n = b.is_unsigned ? std::snprintf(buf, sizeof(buf), "%u", *static_cast<unsigned int*>(b.buffer))
+                          : std::snprintf(buf, sizeof(buf), "%d", *static_cast<int*>(b.buffer));
+        break;
+    case MYSQL_TYPE_LONGLONG:
+        n = b.is_unsigned ? std::snprintf(buf, sizeof(buf), "%llu", *static_cast<unsigned long long*>(b.buffer))
+                          : std::snprintf(buf, sizeof(buf), "%lld", *static_cast<long long*>(b.buffer));
+        break;
+    case MYSQL_TYPE_FLOAT:
+        n = std::snprintf(buf, sizeof(buf), "%.9g", *static_cast<float*>(b.buffer));
+        break;
+    case MYSQL_TYPE_DOUBLE:
+        n = std::snprintf(buf, sizeof(buf), "%.17g", *static_cast<double*>(b.buffer));
+        break;
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_TIMESTAMP: {
+        const MYSQL_TIME* t = static_cast<const MYSQL_TIME*>(b.buffer);
+        n = std::snprintf(buf, sizeof(buf), "'%04u-%02u-%02u %02u:%02u:%02u'",
+            t->year, t->month, t->day, t->hour, t->minute, t->second);
+        break;
+    }
+    case MYSQL_TYPE_STRING:
+    case MYSQL_TYPE_VAR_STRING:
+    case MYSQL_TYPE_BLOB: {
+        const unsigned long len = bindLength(b);
+        std::string escaped(len * 2 + 1, '\0');
+        escaped.resize(mysql_real_escape_string(conn, escaped.data(),
+            static_cast<const char*>(b.buffer), len));
+        out += '\'';
+        out += escaped;
+        out += '\'';
+        return true;
+    }
+    default:
+        return false;
+    }
+    out.append(buf, n);
+    return true;
+}
+
+void writeLine(const std::string& line) {
+    const char* path = std::getenv("AUCTION_SLOW_QUERY_LOG");
+    int fd = (path && *path) ? open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0640) : STDERR_FILENO;
+    if (fd < 0) return;
+    ssize_t ignored = write(fd, line.data(), line.size());
+    (void)ignored;
+    if (fd != STDERR_FILENO) close(fd);
+}
+
+} // namespace
+
+long long SlowQueryLog::thresholdNs() noexcept {
+    static const long long threshold = [] {
+        const char* v = std::getenv("AUCTION_SLOW_QUERY_MS");
+        if (!v || !*v) return -1LL;
+        char* end = nullptr;
+        long long ms = std::strtoll(v, &end, 10);
+        return (end && *end == '\0' && ms >= 0) ? ms * 1000000LL : -1LL;
+    }();
+    return threshold;
+}
+
+// -------------------------------------------------------------
+// Fingerprint: collapse whitespace, fold literals to ?, then
+// fold runs of "?, ?, ..." (IN lists, VALUES rows) to "?+"
+// -------------------------------------------------------------
+std::string SlowQueryLog::fingerprint(std::string_view sql) {
+    std::string flat;
+    flat.reserve(sql.size());
+    bool space = false;
+    for (std::size_t i = 0; i < sql.size();) {
+        const char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            space = !flat.empty();
+            ++i;
+            continue;
+        }
+        if (space) {
+            flat.push_back(' ');
+            space = false;
+        }
+        if (c == '\'' || c == '"') {
+            i = skipQuoted(sql, i);
+            flat.push_back('?');
+        } else if (std::isdigit(static_cast<unsigned char>(c)) && (flat.empty() || !isIdentChar(flat.back()))) {
+            while (i < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '.')) ++i;
+            flat.push_back('?');
+        } else if (c == '`') {
+            const std::size_t end = sql.find('`', i + 1);
+            const std::size_t stop = end == std::string_view::npos ? sql.size() : end + 1;
+            flat.append(sql.substr(i, stop - i));
+            i = stop;
+        } else {
+            flat.push_back(c);
+            ++i;
+        }
+    }
+
+    std::string out;
+    out.reserve(flat.size());
+    for (std::size_t i = 0; i < flat.size();) {
+        if (flat[i] != '?') {
+            out.push_back(flat[i++]);
+            continue;
+        }
+        std::size_t end = i + 1;
+        bool folded = false;
+        for (;;) {
+            std::size_t j = end;
+            while (j < flat.size() && flat[j] == ' ') ++j;
+            if (j >= flat.size() || flat[j] != ',') break;
+            ++j;
+            while (j < flat.size() && flat[j] == ' ') ++j;
+            if (j >= flat.size() || flat[j] != '?') break;
+            end = j + 1;
+            folded = true;
+        }
+        out += folded ? "?+" : "?";
+        i = end;
+    }
+    return out;
+}
+
+std::uint64_t SlowQueryLog::fingerprintId(std::string_view fingerprint) noexcept {
+    std::uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : fingerprint) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h ? h : 1;
+}
+
+std::string SlowQueryLog::paramShapes(const MYSQL_BIND* params, unsigned count) {
+    std::string out;
+    for (unsigned i = 0; params && i < count; ++i) {
+        const MYSQL_BIND& b = params[i];
+        if (i) out.push_back(',');
+        if (bindIsNull(b)) {
+            out += "null";
+            continue;
+        }
+        out += typeName(b.buffer_type);
+        if (b.buffer_type == MYSQL_TYPE_STRING || b.buffer_type == MYSQL_TYPE_VAR_STRING ||
+            b.buffer_type == MYSQL_TYPE_BLOB) {
+            out += '(' + std::to_string(bindLength(b)) + ')';
+        }
+    }
+    return out;
+}
+
+// -------------------------------------------------------------
+// Copy each bound value into 8-byte slots and repoint the binds
+// at them (plain memcpy: formatting waits until a statement is
+// known to be slow)
+// -------------------------------------------------------------
+void SlowQueryLog::Binds::save(const MYSQL_BIND* params, unsigned count) {
+    binds_.clear();
+    lengths_.clear();
+    values_.clear();
+    if (!params) count = 0;
+
+    std::size_t words = 0;
+    for (unsigned i = 0; i < count; ++i)
+        words += bindIsNull(params[i]) ? 0 : (valueBytes(params[i]) + 7) / 8;
+
+    binds_.assign(params, params + count);
+    lengths_.resize(count);
+    values_.resize(words);
+
+    std::size_t at = 0;
+    for (unsigned i = 0; i < count; ++i) {
+        MYSQL_BIND& b = binds_[i];
+        const bool null = bindIsNull(params[i]);
+        const std::size_t bytes = null ? 0 : valueBytes(params[i]);
+        lengths_[i] = static_cast<unsigned long>(bytes);
+        b.length = &lengths_[i];
+        b.is_null = nullptr;
+        if (null) {
+            b.buffer_type = MYSQL_TYPE_NULL;
+            b.buffer = nullptr;
+            continue;
+        }
+        b.buffer = values_.data() + at;
+        if (bytes) std::memcpy(b.buffer, params[i].buffer, bytes);
+        at += (bytes + 7) / 8;
+    }
+}
+
+// -------------------------------------------------------------
+// Inline binds for EXPLAIN (placeholders inside quotes are text)
+// -------------------------------------------------------------
+std::string SlowQueryLog::inlineParams(MYSQL* conn, std::string_view sql,
+    const MYSQL_BIND* params, unsigned count) {
+    std::string out;
+    out.reserve(sql.size() + count * 8);
+    unsigned next = 0;
+    for (std::size_t i = 0; i < sql.size();) {
+        const char c = sql[i];
+        if (c == '\'' || c == '"' || c == '`') {
+            const std::size_t end = (c == '`') ? std::min(sql.find('`', i + 1), sql.size() - 1) + 1
+                                               : skipQuoted(sql, i);
+            out.append(sql.substr(i, end - i));
+            i = end;
+        } else if (c == '?') {
+            if (!params || next >= count || !appendLiteral(out, conn, params[next++]))
+                return {};
+            ++i;
+        } else {
+            out.push_back(c);
+            ++i;
+        }
+    }
+    return next == count ? out : std::string();
+}
+
+// -------------------------------------------------------------
+// Host-wide "EXPLAIN already captured" set: open addressing over
+// a short probe window; a full window counts as already seen
+// -------------------------------------------------------------
+namespace {
+
+Layout* explainedSet() {
+    static SharedSegment segment(kSegmentName, sizeof(Layout));
+    return segment.as<Layout>();
+}
+
+constexpr std::size_t kSlots = sizeof(Layout::ids) / sizeof(Layout::ids[0]);
+
+} // namespace
+
+bool SlowQueryLog::explained(std::uint64_t id) {
+    Layout* shm = explainedSet();
+    if (!shm) return false;
+
+    for (unsigned p = 0; p < kProbe; ++p) {
+        const std::uint64_t seen =
+            std::atomic_ref<std::uint64_t>(shm->ids[(id + p) % kSlots]).load(std::memory_order_acquire);
+        if (seen == id) return true;
+        if (seen == 0) return false;
+    }
+    return true;
+}
+
+void SlowQueryLog::markExplained(std::uint64_t id) {
+    Layout* shm = explainedSet();
+    if (!shm) return;
+
+    for (unsigned p = 0; p < kProbe; ++p) {
+        std::atomic_ref<std::uint64_t> slot(shm->ids[(id + p) % kSlots]);
+        std::uint64_t seen = slot.load(std::memory_order_acquire);
+        if (seen == id) return;
+        if (seen == 0) {
+            if (slot.compare_exchange_strong(seen, id, std::memory_order_acq_rel) || seen == id) return;
+        }
+    }
+}
+
+// -------------------------------------------------------------
+// One JSON line per slow statement
+// -------------------------------------------------------------
+void SlowQueryLog::record(MYSQL* conn, const Entry& e) {
+    const long long threshold = thresholdNs();
+    if (threshold < 0 || e.durNs < threshold) return;
+
+    try {
+        const std::string fp = fingerprint(e.sql);
+        const std::uint64_t id = fingerprintId(fp);
+
+        const MYSQL_BIND* params = e.binds ? e.binds->data() : nullptr;
+        const unsigned count = e.binds ? e.binds->count() : 0;
+
+        std::string explain, explainError;
+        const std::string inlined = (conn && explainable(e.sql) && !explained(id))
+            ? (count ? inlineParams(conn, e.sql, params, count) : std::string(e.sql))
+            : std::string();
+        if (!inlined.empty()) {
+            const std::string sql = "EXPLAIN FORMAT=JSON " + inlined;
+            if (mysql_real_query(conn, sql.data(), sql.size()) != 0) {
+                explainError = mysql_error(conn);
+            } else if (MYSQL_RES* res = mysql_store_result(conn)) {
+                MYSQL_ROW row = mysql_fetch_row(res);
+                unsigned long* lengths = mysql_fetch_lengths(res);
+                if (row && row[0] && lengths) explain.assign(row[0], lengths[0]);
+                mysql_free_result(res);
+                if (!explain.empty()) markExplained(id);
+            } else {
+                explainError = mysql_error(conn);
+            }
+        }
+
+        char idHex[17];
+        std::snprintf(idHex, sizeof(idHex), "%016llx", static_cast<unsigned long long>(id));
+        const char* page = std::getenv("SCRIPT_NAME");
+
+        std::ostringstream line;
+        JsonWriter json(line);
+        json.beginObject()
+            .key("ts").number(static_cast<long long>(std::time(nullptr)))
+            .key("page").string(page ? page : "-")
+            .key("ms").real(static_cast<double>(e.durNs / 1000) / 1000.0)
+            .key("id").string(idHex)
+            .key("fingerprint").string(fp)
+            .key("params").string(paramShapes(params, count))
+            .key("rows").number(static_cast<long long>(e.rows));
+        if (e.affected >= 0) json.key("affected").number(e.affected);
+        if (!explain.empty()) json.key("explain").string(explain);
+        if (!explainError.empty()) json.key("explain_error").string(explainError);
+        json.endObject();
+        line << '\n';
+        writeLine(line.str());
+    } catch (...) {
+        // Logging must never take a request down
+    }
+}
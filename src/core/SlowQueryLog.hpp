@@ -0,0 +1,89 @@
+// core/SlowQueryLog.hpp
+#pragma once
+
+#include <cstdint>
+#include <mysql/mysql.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =============================================================
+// SlowQueryLog — Team Elevate Auctions
+// Application-side slow query log. Every Statement times its
+// prepare, execute and fetch calls (time spent rendering
+// between fetches does not count); one that spends longer than
+// AUCTION_SLOW_QUERY_MS in the database is written as a JSON
+// line to AUCTION_SLOW_QUERY_LOG (default stderr) with:
+//
+//  - its fingerprint: whitespace collapsed, literals and IN/
+//    VALUES lists folded to ?, plus a 64-bit id of that text
+//  - bind-parameter shapes (types and lengths, never values)
+//  - rows fetched and rows affected
+//  - EXPLAIN FORMAT=JSON, until one has been captured for the
+//    fingerprint on this host (tracked in a SharedSegment), run on
+//    the statement's connection with the bound values inlined
+//
+// The plan's conditions (attached_condition and the like) echo
+// those inlined values, so the log can hold emails, tokens and
+// search terms: keep it as private as the database itself.
+//
+// Unset (the default), statements pay one cached branch. While
+// it is on, execute() only copies the bound values; shapes and
+// the inlined EXPLAIN text are built for slow statements alone.
+// =============================================================
+class SlowQueryLog {
+public:
+    // Bound values as of execute(): raw bytes copied out of the
+    // caller's buffers, which may be gone or reused by the time
+    // the statement finishes
+    class Binds {
+    public:
+        void save(const MYSQL_BIND* params, unsigned count);
+
+        const MYSQL_BIND* data() const noexcept { return binds_.data(); }
+        unsigned count() const noexcept { return static_cast<unsigned>(binds_.size()); }
+
+    private:
+        std::vector<MYSQL_BIND> binds_;       // buffers point into values_
+        std::vector<unsigned long> lengths_;
+        std::vector<std::uint64_t> values_;   // 8-byte aligned copies
+    };
+
+    // What Statement hands over when it finishes
+    struct Entry {
+        std::string_view sql;
+        const Binds* binds;
+        long long durNs;
+        unsigned long long rows;
+        long long affected;            // -1 when not a write
+    };
+
+    static bool enabled() noexcept { return thresholdNs() >= 0; }
+
+    // AUCTION_SLOW_QUERY_MS in ns, -1 when unset (read once)
+    static long long thresholdNs() noexcept;
+
+    // Normalized statement text and its FNV-1a id
+    static std::string fingerprint(std::string_view sql);
+    static std::uint64_t fingerprintId(std::string_view fingerprint) noexcept;
+
+    // "type(len),..." for `count` bound parameters
+    static std::string paramShapes(const MYSQL_BIND* params, unsigned count);
+
+    // `sql` with each ? replaced by the bound value as an escaped
+    // literal; empty when a bind cannot be rendered
+    static std::string inlineParams(MYSQL* conn, std::string_view sql,
+        const MYSQL_BIND* params, unsigned count);
+
+    // Log `e` if it exceeded the threshold. `conn` must be idle
+    // (no unread result) since EXPLAIN runs on it.
+    static void record(MYSQL* conn, const Entry& e);
+
+private:
+    // Host-wide: a plan for this id was already captured. An id
+    // is only marked after its EXPLAIN succeeded, so one that
+    // failed (binds not renderable, busy connection) is retried
+    // the next time the statement is slow.
+    static bool explained(std::uint64_t id);
+    static void markExplained(std::uint64_t id);
+};
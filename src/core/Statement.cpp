@@ -0,0 +1,141 @@
+// core/Statement.cpp
+#include "core/Statement.hpp"
+#include "core/Metrics.hpp"
+#include "core/SlowQueryLog.hpp"
+#include "core/Trace.hpp"
+
+Statement::Statement(Database& db, std::string_view sql, Database::Route route)
+    : stats_(db.stats()), conn_(db.connection(route)),
+      writer_(route == Database::Route::Primary ? &db : nullptr),
+      timed_(Trace::enabled() || SlowQueryLog::enabled()) {
+    if (!conn_) return;
+
+    stmt_ = mysql_stmt_init(conn_);
+    if (!stmt_) return;
+
+    traceId_ = ++stats_.statements;
+    ++stats_.roundTrips;
+    if (SlowQueryLog::enabled()) sql_.assign(sql);
+
+    Trace::Span span("prepare", sql, traceId_);
+    const long long start = timed_ ? Trace::nowNs() : 0;
+    prepared_ = (mysql_stmt_prepare(stmt_, sql.data(), sql.size()) == 0);
+    if (timed_) dbNs_ += Trace::nowNs() - start;
+    if (!prepared_) Metrics::add(Metrics::DbPrepareError);
+}
+
+// -------------------------------------------------------------
+// The slow query check runs after close, when the connection is
+// free for its EXPLAIN
+// -------------------------------------------------------------
+Statement::~Statement() {
+    if (fetchNs_) Trace::record("fetch", fetchStartNs_, fetchNs_, {}, traceId_);
+    if (stmt_) {
+        mysql_stmt_close(stmt_);
+        stmt_ = nullptr;
+    }
+    if (prepared_ && !sql_.empty()) {
+        SlowQueryLog::record(conn_, SlowQueryLog::Entry{
+            sql_, &binds_, dbNs_, fetched_, affected_ });
+    }
+}
+
+bool Statement::bindParams(MYSQL_BIND* params) {
+    if (!ok() || mysql_stmt_bind_param(stmt_, params) != 0) return false;
+    params_ = params;
+    return true;
+}
+
+// -------------------------------------------------------------
+// Execute; cursor attributes must be set before execution
+// -------------------------------------------------------------
+bool Statement::execute(Fetch mode, unsigned long prefetchRows) {
+    if (!ok()) return false;
+    mode_ = mode;
+    stored_ = false;
+    prefetch_ = prefetchRows ? prefetchRows : 1;
+    fetched_ = 0;
+
+    if (mode == Fetch::Cursor) {
+        unsigned long type = CURSOR_TYPE_READ_ONLY;
+        mysql_stmt_attr_set(stmt_, STMT_ATTR_CURSOR_TYPE, &type);
+        mysql_stmt_attr_set(stmt_, STMT_ATTR_PREFETCH_ROWS, &prefetchRows);
+    }
+    if (!sql_.empty())
+        binds_.save(params_, mysql_stmt_param_count(stmt_));
+
+    ++stats_.roundTrips;
+    Trace::Span span("execute", {}, traceId_);
+    const long long start = Trace::nowNs();
+    const bool executed = mysql_stmt_execute(stmt_) == 0;
+    const long long elapsed = Trace::nowNs() - start;
+    dbNs_ += elapsed;
+    Metrics::observeQuery(elapsed);
+    if (!executed) Metrics::add(Metrics::DbExecuteError);
+
+    // A statement without a result set changed something the
+    // user may read back: later reads stay on the primary
+    if (executed && writer_ && mysql_stmt_field_count(stmt_) == 0)
+        writer_->noteWrite();
+
+    if (!sql_.empty() && executed && mysql_stmt_field_count(stmt_) == 0)
+        affected_ = static_cast<long long>(mysql_stmt_affected_rows(stmt_));
+    return executed;
+}
+
+bool Statement::bindResult(MYSQL_BIND* result) {
+    return ok() && mysql_stmt_bind_result(stmt_, result) == 0;
+}
+
+// -------------------------------------------------------------
+// Buffered mode stores lazily on the first fetch so callers can
+// bind results in either order relative to execute()
+// -------------------------------------------------------------
+bool Statement::fetch() {
+    if (!timed_) return fetchRow();
+
+    const long long start = Trace::nowNs();
+    const bool row = fetchRow();
+    const long long elapsed = Trace::nowNs() - start;
+    dbNs_ += elapsed;
+    if (Trace::enabled()) {
+        if (!fetchNs_) fetchStartNs_ = start;
+        fetchNs_ += elapsed;
+    }
+    return row;
+}
+
+bool Statement::fetchRow() {
+    if (!ok()) return false;
+    if (mode_ == Fetch::Buffered && !stored_) {
+        ++stats_.roundTrips;
+        if (mysql_stmt_store_result(stmt_) != 0) {
+            failed_ = true;
+            return false;
+        }
+        stored_ = true;
+    }
+    // A cursor asks the server for another block every prefetch_ rows
+    if (mode_ == Fetch::Cursor && fetched_ % prefetch_ == 0) ++stats_.roundTrips;
+
+    int status = mysql_stmt_fetch(stmt_);
+    if (status != 0 && status != MYSQL_DATA_TRUNCATED) {
+        failed_ = status != MYSQL_NO_DATA;
+        return false;
+    }
+    ++fetched_;
+    ++stats_.rows;
+    return true;
+}
+
+unsigned long long Statement::affectedRows() const {
+    return stmt_ ? mysql_stmt_affected_rows(stmt_) : 0;
+}
+
+unsigned long long Statement::insertId() const {
+    return stmt_ ? mysql_stmt_insert_id(stmt_) : 0;
+}
+
+const char* Statement::error() const {
+    return stmt_ ? mysql_stmt_error(stmt_) : "statement not initialized";
+}
@@ -0,0 +1,90 @@
+// core/Statement.hpp
+#pragma once
+
+#include <mysql/mysql.h>
+#include <string>
+#include <string_view>
+#include "core/Database.hpp"
+#include "core/SlowQueryLog.hpp"
+
+// =============================================================
+// Statement — Team Elevate Auctions
+// RAII wrapper around MYSQL_STMT: prepares on construction and
+// closes on destruction, so early returns cannot leak handles.
+// When Trace or SlowQueryLog is on, the time spent in prepare,
+// execute and fetch is summed and reported at destruction.
+// =============================================================
+class Statement {
+public:
+    // How rows come back after execute():
+    //   Buffered  — mysql_stmt_store_result(); whole set copied to
+    //               the client first (needed when other statements
+    //               run on the connection while rows are read)
+    //   Streaming — unbuffered; each fetch() pulls the next row off
+    //               the wire, so memory stays flat in the row count.
+    //               The connection is busy until the set is drained.
+    //   Cursor    — server-side read-only cursor, fetched in blocks
+    //               of `prefetchRows` (STMT_ATTR_PREFETCH_ROWS)
+    enum class Fetch { Buffered, Streaming, Cursor };
+
+    // Runs on the primary unless `route` allows a replica; a
+    // primary statement without a result set counts as a write
+    Statement(Database& db, std::string_view sql, Database::Route route = Database::Route::Primary);
+    ~Statement();
+
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+
+    // True when the statement prepared successfully
+    bool ok() const noexcept { return stmt_ != nullptr && prepared_; }
+
+    bool bindParams(MYSQL_BIND* params);
+    bool execute(Fetch mode = Fetch::Buffered, unsigned long prefetchRows = 64);
+    bool bindResult(MYSQL_BIND* result);
+
+    // Next row into the bound result buffers; false at end or on
+    // error. Truncated columns still count as a row — callers
+    // clamp lengths to their buffer sizes.
+    bool fetch();
+
+    // True once fetch() stopped on an error (lost connection,
+    // failed store) rather than at the end of the rows; loops
+    // check it so a cut-off result is not taken as complete.
+    bool failed() const noexcept { return failed_; }
+
+    unsigned long long affectedRows() const;
+    unsigned long long insertId() const;
+    const char* error() const;
+
+    MYSQL_STMT* handle() const noexcept { return stmt_; }
+
+private:
+    bool fetchRow();
+
+    QueryStats& stats_;
+    MYSQL* conn_;
+    Database* writer_;            // set for Route::Primary (write tracking)
+    MYSQL_STMT* stmt_ = nullptr;
+    bool prepared_ = false;
+    bool failed_ = false;
+    Fetch mode_ = Fetch::Buffered;
+    bool stored_ = false;
+    unsigned long prefetch_ = 0;
+    unsigned long fetched_ = 0;
+
+    // Tracing: this statement's number on the connection, and its
+    // fetch time summed into one span at destruction
+    const bool timed_;
+    unsigned traceId_ = 0;
+    long long fetchStartNs_ = 0;
+    long long fetchNs_ = 0;
+    long long dbNs_ = 0;          // prepare + execute + fetch
+
+    // Slow query log (filled only while it is enabled); the bound
+    // values are copied at execute(), while the caller's buffers
+    // are live, and only formatted if the statement turns out slow
+    std::string sql_;
+    SlowQueryLog::Binds binds_;
+    MYSQL_BIND* params_ = nullptr;
+    long long affected_ = -1;
+};
@@ -0,0 +1,96 @@
+// core/TokenBuckets.cpp
+#include "core/TokenBuckets.hpp"
+#include <atomic>
+#include <ctime>
+
+static constexpr std::uint64_t kMilli = 1000;
+
+static std::uint32_t nowCentis() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::uint32_t>(ts.tv_sec * 100 + ts.tv_nsec / 10000000);
+}
+
+TokenBuckets::TokenBuckets(std::string_view name)
+    : segment_(name, sizeof(Layout)),
+      data_(segment_.as<Layout>()) {
+}
+
+// -------------------------------------------------------------
+// Refill by elapsed time, then take one token (CAS loop)
+// -------------------------------------------------------------
+unsigned TokenBuckets::take(std::uint64_t& word, Rate rate) {
+    if (rate.perMinute == 0 || rate.burst == 0) return 0;   // unlimited
+
+    std::atomic_ref<std::uint64_t> bucket(word);
+    const std::uint64_t capacity = rate.burst * kMilli;
+
+    std::uint64_t old = bucket.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint32_t now = nowCentis();
+        std::uint64_t tokens;
+        if (old == 0) {
+            tokens = capacity;
+        } else {
+            const std::uint32_t last = static_cast<std::uint32_t>(old >> 32);
+            const std::uint64_t elapsed = static_cast<std::uint32_t>(now - last);
+            tokens = (old & 0xFFFFFFFFu) + elapsed * rate.perMinute * kMilli / 6000;
+            if (tokens > capacity) tokens = capacity;
+        }
+
+        if (tokens < kMilli) {
+            // Whole seconds until the missing fraction refills
+            const std::uint64_t missing = kMilli - tokens;
+            const std::uint64_t centis = (missing * 6000 + rate.perMinute * kMilli - 1) / (rate.perMinute * kMilli);
+            return centis < 100 ? 1u : static_cast<unsigned>((centis + 99) / 100);
+        }
+
+        // `now | 1` keeps a real timestamp from ever encoding as the
+        // all-zero "untouched" word
+        const std::uint64_t next = (static_cast<std::uint64_t>(now | 1u) << 32) | (tokens - kMilli);
+        if (bucket.compare_exchange_weak(old, next, std::memory_order_relaxed))
+            return 0;
+    }
+}
+
+// -------------------------------------------------------------
+// Add one token back, keeping the refill timestamp (CAS loop)
+// -------------------------------------------------------------
+void TokenBuckets::refund(std::uint64_t& word, Rate rate) {
+    if (rate.perMinute == 0 || rate.burst == 0) return;
+
+    std::atomic_ref<std::uint64_t> bucket(word);
+    const std::uint64_t capacity = rate.burst * kMilli;
+
+    std::uint64_t old = bucket.load(std::memory_order_relaxed);
+    for (;;) {
+        if (old == 0) return;   // untouched: already full
+        std::uint64_t tokens = (old & 0xFFFFFFFFu) + kMilli;
+        if (tokens > capacity) tokens = capacity;
+        const std::uint64_t next = (old & 0xFFFFFFFF00000000ull) | tokens;
+        if (bucket.compare_exchange_weak(old, next, std::memory_order_relaxed))
+            return;
+    }
+}
+
+std::uint64_t& TokenBuckets::userWord(long userId) {
+    // Fibonacci hashing spreads sequential ids across the table
+    const std::uint64_t h = static_cast<std::uint64_t>(userId) * 11400714819323198485ull;
+    return data_->users[(h >> 32) % kUserSlots];
+}
+
+unsigned TokenBuckets::takeGlobal(Rate rate) {
+    return data_ ? take(data_->global, rate) : 0;
+}
+
+unsigned TokenBuckets::takeUser(long userId, Rate rate) {
+    return data_ ? take(userWord(userId), rate) : 0;
+}
+
+void TokenBuckets::refundGlobal(Rate rate) {
+    if (data_) refund(data_->global, rate);
+}
+
+void TokenBuckets::refundUser(long userId, Rate rate) {
+    if (data_) refund(userWord(userId), rate);
+}
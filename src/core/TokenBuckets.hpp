@@ -0,0 +1,57 @@
+// core/TokenBuckets.hpp
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include "core/SharedSegment.hpp"
+
+// =============================================================
+// TokenBuckets — Team Elevate Auctions
+// Table of token buckets shared across CGI processes: one global
+// bucket plus kUserSlots per-user buckets (user ids hash into
+// slots; the rare collision just shares a budget). Each bucket
+// is one 64-bit word updated by compare-and-swap:
+//
+//   [63..32] last refill, centiseconds of CLOCK_MONOTONIC (wraps)
+//   [31.. 0] tokens, in thousandths
+//
+// A zero word is a full bucket that has never been touched.
+// When the segment is unavailable every take() succeeds.
+// =============================================================
+class TokenBuckets {
+public:
+    static constexpr unsigned kUserSlots = 4096;
+
+    struct Rate {
+        unsigned perMinute;   // steady refill
+        unsigned burst;       // capacity
+    };
+
+    explicit TokenBuckets(std::string_view name);
+
+    bool ok() const noexcept { return data_ != nullptr; }
+
+    // Take one token. Returns 0 on success, otherwise the number
+    // of seconds until a token will be available (>= 1).
+    unsigned takeGlobal(Rate rate);
+    unsigned takeUser(long userId, Rate rate);
+
+    // Hand back a token taken by a request that was then refused
+    // further along (never beyond the burst)
+    void refundGlobal(Rate rate);
+    void refundUser(long userId, Rate rate);
+
+private:
+    struct Layout {
+        std::uint64_t global;
+        std::uint64_t users[kUserSlots];
+    };
+
+    SharedSegment segment_;
+    Layout* data_;
+
+    std::uint64_t& userWord(long userId);
+
+    static unsigned take(std::uint64_t& word, Rate rate);
+    static void refund(std::uint64_t& word, Rate rate);
+};
@@ -0,0 +1,194 @@
+// core/Trace.cpp
+#include "core/Trace.hpp"
+#include "utils/JsonWriter.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+struct Event {
+    const char* name;
+    long long startNs;
+    long long durNs;
+    unsigned stmt;
+    unsigned detailLen;
+    char detail[Trace::kDetailChars];
+};
+
+struct Total {
+    const char* name;
+    long long ns;
+    unsigned count;
+};
+
+Event gEvents[Trace::kMaxEvents];
+unsigned gEventCount = 0;
+unsigned gDropped = 0;
+
+Total gTotals[Trace::kMaxNames];
+unsigned gTotalCount = 0;
+
+// Spans start relative to process start (static init)
+const long long gOriginNs = Trace::nowNs();
+
+bool tracingRequested() {
+    const char* on = std::getenv("AUCTION_TRACE");
+    const char* log = std::getenv("AUCTION_TRACE_LOG");
+    return (on && *on && std::strcmp(on, "0") != 0) || (log && *log);
+}
+
+double toMs(long long ns) { return static_cast<double>(ns / 1000) / 1000.0; }
+
+} // namespace
+
+bool Trace::enabled_ = tracingRequested();
+
+long long Trace::nowNs() noexcept {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+long long Trace::sinceStartNs() noexcept {
+    return nowNs() - gOriginNs;
+}
+
+// -------------------------------------------------------------
+// Per-name totals always; individual events until the table is
+// full (later ones are only counted as dropped)
+// -------------------------------------------------------------
+void Trace::record(const char* name, long long startNs, long long durNs,
+    std::string_view detail, unsigned stmt) noexcept {
+    if (!enabled_) return;
+
+    Total* total = nullptr;
+    for (unsigned i = 0; i < gTotalCount; ++i) {
+        if (gTotals[i].name == name || std::strcmp(gTotals[i].name, name) == 0) {
+            total = &gTotals[i];
+            break;
+        }
+    }
+    if (!total && gTotalCount < kMaxNames) {
+        total = &gTotals[gTotalCount++];
+        *total = Total{ name, 0, 0 };
+    }
+    if (total) {
+        total->ns += durNs;
+        ++total->count;
+    }
+
+    if (gEventCount == kMaxEvents) {
+        ++gDropped;
+        return;
+    }
+    Event& e = gEvents[gEventCount++];
+    e.name = name;
+    e.startNs = startNs;
+    e.durNs = durNs;
+    e.stmt = stmt;
+    e.detailLen = static_cast<unsigned>(std::min<std::size_t>(detail.size(), kDetailChars));
+    std::memcpy(e.detail, detail.data(), e.detailLen);
+}
+
+// -------------------------------------------------------------
+// Server-Timing: name;dur=ms;desc="N calls" per span name
+// -------------------------------------------------------------
+void Trace::writeHeader(std::ostream& out) {
+    if (!enabled_) return;
+
+    char buf[96];
+    out << "Server-Timing: ";
+    for (unsigned i = 0; i < gTotalCount; ++i) {
+        const Total& t = gTotals[i];
+        int n = (t.count > 1)
+            ? std::snprintf(buf, sizeof(buf), "%s;dur=%.3f;desc=\"%u calls\", ", t.name, toMs(t.ns), t.count)
+            : std::snprintf(buf, sizeof(buf), "%s;dur=%.3f, ", t.name, toMs(t.ns));
+        out.write(buf, std::min<int>(n, sizeof(buf) - 1));
+    }
+    int n = std::snprintf(buf, sizeof(buf), "total;dur=%.3f\r\n", toMs(nowNs() - gOriginNs));
+    out.write(buf, std::min<int>(n, sizeof(buf) - 1));
+}
+
+// -------------------------------------------------------------
+// One JSON line per request, appended with a single write() so
+// concurrent CGIs do not interleave within a line
+// -------------------------------------------------------------
+void Trace::writeLog() {
+    const char* path = std::getenv("AUCTION_TRACE_LOG");
+    if (!enabled_ || !path || !*path) return;
+
+    const char* page = std::getenv("SCRIPT_NAME");
+    const char* method = std::getenv("REQUEST_METHOD");
+
+    std::ostringstream line;
+    JsonWriter json(line);
+    json.beginObject()
+        .key("ts").number(static_cast<long long>(std::time(nullptr)))
+        .key("pid").number(static_cast<long long>(getpid()))
+        .key("page").string(page ? page : "-")
+        .key("method").string(method ? method : "GET")
+        .key("total_us").number((nowNs() - gOriginNs) / 1000)
+        .key("dropped").number(gDropped)
+        .key("spans").beginArray();
+    for (unsigned i = 0; i < gEventCount; ++i) {
+        const Event& e = gEvents[i];
+        json.beginObject()
+            .key("name").string(e.name)
+            .key("start_us").number((e.startNs - gOriginNs) / 1000)
+            .key("dur_us").number(e.durNs / 1000);
+        if (e.stmt) json.key("stmt").number(e.stmt);
+        if (e.detailLen) json.key("sql").string(std::string_view(e.detail, e.detailLen));
+        json.endObject();
+    }
+    json.endArray().endObject();
+    line << '\n';
+
+    const std::string text = line.str();
+    int fd = open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0640);
+    if (fd < 0) return;
+    ssize_t ignored = write(fd, text.data(), text.size());
+    (void)ignored;
+    close(fd);
+}
+
+// -------------------------------------------------------------
+// Capture: buffer the response, then emit it with the header
+// -------------------------------------------------------------
+Trace::Capture::Capture() {
+    if (!enabled_) return;
+    buffer_ = std::make_unique<std::stringbuf>();
+    real_ = std::cout.rdbuf(buffer_.get());
+}
+
+Trace::Capture::~Capture() {
+    if (!buffer_) return;
+    std::cout.flush();
+    std::cout.rdbuf(real_);
+
+    // CGI allows bare LF line ends too; insert after the last header line
+    const std::string out = buffer_->str();
+    const std::size_t crlf = out.find("\r\n\r\n");
+    const std::size_t lf = out.find("\n\n");
+    std::size_t split = std::string::npos;
+    if (crlf != std::string::npos && crlf < lf) split = crlf + 2;
+    else if (lf != std::string::npos) split = lf + 1;
+
+    if (split == std::string::npos) {
+        std::cout << out;
+    } else {
+        std::cout.write(out.data(), split);
+        writeHeader(std::cout);
+        std::cout.write(out.data() + split, out.size() - split);
+    }
+    std::cout.flush();
+    writeLog();
+}
@@ -0,0 +1,93 @@
+// core/Trace.hpp
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+
+// =============================================================
+// Trace — Team Elevate Auctions
+// Per-request span timing for one CGI process. Spans are named
+// phases (db-connect, session, prepare, execute, fetch, render)
+// recorded into fixed process-wide tables, so recording a span
+// never allocates.
+//
+//  - AUCTION_TRACE=1 adds a Server-Timing header to every Page
+//    response: one entry per span name with its summed duration
+//    and call count, plus "total" (process start to response).
+//  - AUCTION_TRACE_LOG=<path> also appends one JSON line per
+//    request with every span (start/duration in µs, statement
+//    number, SQL text for prepares) — setting it alone enables
+//    tracing as well.
+//
+// Disabled (the default), a Span is one load of a static bool.
+// Enabled, Page::run buffers the response in a Capture so the
+// header can carry phases that finish after the body starts;
+// streaming responses (events.cgi) are never captured.
+// =============================================================
+class Trace {
+public:
+    static constexpr unsigned kMaxEvents = 256;   // individual spans kept for the log
+    static constexpr unsigned kMaxNames = 16;     // distinct span names in the header
+    static constexpr unsigned kDetailChars = 120; // SQL text kept per span
+
+    static bool enabled() noexcept { return enabled_; }
+
+    // CLOCK_MONOTONIC in nanoseconds
+    static long long nowNs() noexcept;
+
+    // Elapsed since the process started (static initialization)
+    static long long sinceStartNs() noexcept;
+
+    // Add one finished span. `name` must be a string literal (it
+    // is kept by pointer); `detail` is copied and truncated;
+    // `stmt` is the connection's statement number, 0 for none.
+    static void record(const char* name, long long startNs, long long durNs,
+        std::string_view detail = {}, unsigned stmt = 0) noexcept;
+
+    // Times its own scope
+    class Span {
+    public:
+        explicit Span(const char* name, std::string_view detail = {}, unsigned stmt = 0) noexcept
+            : name_(name), detail_(detail), stmt_(stmt), start_(enabled_ ? nowNs() : 0) {}
+        ~Span() {
+            if (start_) record(name_, start_, nowNs() - start_, detail_, stmt_);
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char* name_;
+        std::string_view detail_;
+        unsigned stmt_;
+        long long start_;
+    };
+
+    // Holds everything written to std::cout for its lifetime
+    // (only when tracing is on). On destruction the output goes
+    // to the real stream with Server-Timing inserted before the
+    // blank line that ends the CGI headers, and the log line is
+    // written.
+    class Capture {
+    public:
+        Capture();
+        ~Capture();
+
+        Capture(const Capture&) = delete;
+        Capture& operator=(const Capture&) = delete;
+
+    private:
+        std::unique_ptr<std::stringbuf> buffer_;
+        std::streambuf* real_ = nullptr;
+    };
+
+    // "Server-Timing: ...\r\n" for the spans recorded so far
+    static void writeHeader(std::ostream& out);
+
+    // Appends this request's JSON line to AUCTION_TRACE_LOG
+    static void writeLog();
+
+private:
+    static bool enabled_;
+};
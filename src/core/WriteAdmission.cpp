@@ -0,0 +1,62 @@
+// core/WriteAdmission.cpp
+#include "core/WriteAdmission.hpp"
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+// AUCTION_<NAME>_<suffix> as an unsigned, else `fallback`
+static unsigned envFor(const std::string& upper, const char* suffix, unsigned fallback) {
+    std::string key = "AUCTION_" + upper + "_" + suffix;
+    const char* v = std::getenv(key.c_str());
+    if (!v || !*v) return fallback;
+    unsigned out = 0;
+    const char* end = v + std::strlen(v);
+    auto [ptr, ec] = std::from_chars(v, end, out);
+    return (ec == std::errc() && ptr == end) ? out : fallback;
+}
+
+static std::string upperName(std::string_view name) {
+    std::string upper;
+    for (char c : name)
+        upper += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return upper;
+}
+
+static std::string slotName(std::string_view name) {
+    std::string s(name);
+    s += "-write";
+    return s;
+}
+
+WriteAdmission::WriteAdmission(std::string_view name, long userId, const Defaults& defaults)
+    : slot_(slotName(name), envFor(upperName(name), "SLOTS", defaults.slots)) {
+    const std::string upper = upperName(name);
+
+    const TokenBuckets::Rate user{
+        envFor(upper, "USER_PER_MIN", defaults.user.perMinute),
+        envFor(upper, "USER_BURST", defaults.user.burst) };
+    const TokenBuckets::Rate global{
+        envFor(upper, "GLOBAL_PER_MIN", defaults.global.perMinute),
+        envFor(upper, "GLOBAL_BURST", defaults.global.burst) };
+
+    // Cheapest and most specific first: one user's burst should
+    // not spend the global budget. A refusal further along hands
+    // the tokens already taken back, so it costs the user nothing.
+    TokenBuckets buckets(slotName(name) + "-buckets-v1");
+    if ((retryAfter_ = buckets.takeUser(userId, user)) != 0)
+        return;
+    if ((retryAfter_ = buckets.takeGlobal(global)) != 0) {
+        buckets.refundUser(userId, user);
+        return;
+    }
+
+    if (!slot_.acquire(envFor(upper, "QUEUE_MS", defaults.queueMs))) {
+        buckets.refundGlobal(global);
+        buckets.refundUser(userId, user);
+        retryAfter_ = 1;
+        return;
+    }
+    retryAfter_ = 0;
+    admitted_ = true;
+}
@@ -0,0 +1,52 @@
+// core/WriteAdmission.hpp
+#pragma once
+
+#include <string>
+#include <string_view>
+#include "core/ConcurrencyLimiter.hpp"
+#include "core/TokenBuckets.hpp"
+
+// =============================================================
+// WriteAdmission — Team Elevate Auctions
+// Gate in front of a write path (bid, sell). Admits a request
+// only when
+//   1) the user's token bucket has a token,
+//   2) the path's global token bucket has a token, and
+//   3) one of the path's concurrency slots frees up within a
+//      short queue timeout,
+// and then holds that slot for its own lifetime. A refused
+// request gets back any token it took on the way. Refusals are
+// meant to be answered immediately with 429 + retryAfter(), so a
+// bidding storm queues at the edge instead of inside MariaDB.
+//
+// Limits come from the environment, per path (NAME = BID, SELL):
+//   AUCTION_<NAME>_USER_PER_MIN / _USER_BURST
+//   AUCTION_<NAME>_GLOBAL_PER_MIN / _GLOBAL_BURST
+//   AUCTION_<NAME>_SLOTS, AUCTION_<NAME>_QUEUE_MS
+// A zero rate disables that bucket.
+// =============================================================
+class WriteAdmission {
+public:
+    struct Defaults {
+        TokenBuckets::Rate user;
+        TokenBuckets::Rate global;
+        unsigned slots;
+        unsigned queueMs;
+    };
+
+    // `name` is the lower-case path name ("bid", "sell")
+    WriteAdmission(std::string_view name, long userId, const Defaults& defaults);
+
+    WriteAdmission(const WriteAdmission&) = delete;
+    WriteAdmission& operator=(const WriteAdmission&) = delete;
+
+    bool admitted() const noexcept { return admitted_; }
+
+    // Seconds a refused client should wait (>= 1)
+    unsigned retryAfter() const noexcept { return retryAfter_; }
+
+private:
+    ConcurrencyLimiter slot_;
+    bool admitted_ = false;
+    unsigned retryAfter_ = 1;
+};
@@ -0,0 +1,22 @@
+// main_api.cpp
+#include "core/Database.hpp"
+#include "core/Session.hpp"
+#include "pages/ApiPage.hpp"
+#include <iostream>
+#include <exception>
+
+int main() {
+    try {
+        Database db;
+        Session session(db);
+        RequestContext ctx(db, session);
+
+        ApiPage page(ctx);
+        return page.run();
+    } catch (const std::exception& e) {
+        std::cout << "Status: 500 Internal Server Error\r\n"
+                  << "Content-Type: application/json\r\n\r\n"
+                  << "{\"error\":\"server_error\",\"message\":\"Something went wrong.\"}\n";
+        return 1;
+    }
+}
@@ -2,16 +2,8 @@
 // -------------------------------------------------------------
 // Entry point for Bid page (CGI: bid.cgi)
 //
-// This file intentionally stays minimal so backend devs can
-// later add routing/lookup logic (e.g., reading ?item_id=...,
-// loading item details, auth checks, etc.).
-//
-// TODO ideas for backend:
-// 1) Parse QUERY_STRING to get `item_id` and load item from DB.
-// 2) Pass loaded item data to BidPage (via setters or extend
-//    BidPage ctor to accept an item DTO).
-// 3) Enforce login (redirect to login.cgi if not logged in).
-// 4) Add graceful error handling for missing/invalid items.
+// BidPage dispatches on the query: ?item_id=N shows that item,
+// otherwise the searchable picker (?q=, ?page=).
 // -------------------------------------------------------------
 
 #include "core/Database.hpp"
@@ -26,9 +18,10 @@ int main() {
         // Initialize shared services
         Database db;          // connects lazily or in ctor depending on your impl
         Session session(db);  // session backed by DB
+        RequestContext ctx(db, session);
 
         // Render the page (handles GET/POST internally)
-        BidPage page(db, session);
+        BidPage page(ctx);
         return page.run();
     }
     catch (const std::exception& e) {
@@ -12,8 +12,9 @@ int main() {
         // already reads them from a config/env. Otherwise, adjust here.
         Database db;
         Session session(db);
+        RequestContext ctx(db, session);
 
-        BrowsePage page(db, session);
+        BrowsePage page(ctx);
         return page.run();
     } catch (const std::exception& e) {
         // CGI error fallback: always emit the header before any HTML
@@ -0,0 +1,30 @@
+// main_events.cpp
+#include "core/Database.hpp"
+#include "core/Session.hpp"
+#include "pages/EventStream.hpp"
+#include <iostream>
+#include <exception>
+
+int main() {
+    // Resolve the viewer, then drop the connection: a stream stays
+    // open for minutes and must not hold a MariaDB connection.
+    long viewerId = 0;
+    try {
+        Database db;
+        Session session(db);
+        if (session.validate())
+            viewerId = session.userId();
+    } catch (const std::exception&) {
+        // Prices are public; stream anonymously
+    }
+
+    try {
+        EventStream stream(viewerId);
+        return stream.run();
+    } catch (const std::exception& e) {
+        std::cout << "Status: 500 Internal Server Error\r\n"
+                  << "Content-Type: text/plain\r\n\r\n"
+                  << "Event stream unavailable.\n";
+        return 1;
+    }
+}
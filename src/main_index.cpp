@@ -1,6 +1,7 @@
 // main_index.cpp
 #include "core/Database.hpp"
 #include "core/Session.hpp"
+#include "core/RequestContext.hpp"
 #include "pages/IndexPage.hpp"
 #include <iostream>
 
@@ -8,7 +9,8 @@ int main() {
     try {
         Database db;
         Session session(db);
-        IndexPage page(db, session);
+        RequestContext ctx(db, session);
+        IndexPage page(ctx);
         return page.run();
     }
     catch (const std::exception& e) {
@@ -2,6 +2,7 @@
 // main_login.cpp
 #include "core/Database.hpp"
 #include "core/Session.hpp"
+#include "core/RequestContext.hpp"
 #include "pages/LoginPage.hpp"
 #include <iostream>
 
@@ -9,7 +10,8 @@ int main() {
     try {
         Database db;
         Session session(db);
-        LoginPage page(db, session);
+        RequestContext ctx(db, session);
+        LoginPage page(ctx);
         return page.run();
     }
     catch (const std::exception& e) {
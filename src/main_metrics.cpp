@@ -0,0 +1,14 @@
+// main_metrics.cpp
+#include "core/Metrics.hpp"
+#include <iostream>
+
+// Prometheus scrape target: merges the shared metrics segment.
+// Needs no database connection; restrict access to the scraper
+// in the web server configuration.
+int main() {
+    std::cout << "Content-Type: text/plain; version=0.0.4\r\n"
+              << "Cache-Control: no-store\r\n\r\n";
+    Metrics::writePrometheus(std::cout);
+    std::cout.flush();
+    return 0;
+}
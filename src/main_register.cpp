@@ -1,6 +1,7 @@
 // main_register.cpp
 #include "core/Database.hpp"
 #include "core/Session.hpp"
+#include "core/RequestContext.hpp"
 #include "pages/RegisterPage.hpp"
 #include <iostream>
 
@@ -8,7 +9,8 @@ int main() {
     try {
         Database db;
         Session session(db);
-        RegisterPage page(db, session);
+        RequestContext ctx(db, session);
+        RegisterPage page(ctx);
         return page.run();
     }
     catch (const std::exception& e) {
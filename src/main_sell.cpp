@@ -8,7 +8,8 @@ int main() {
     try {
         Database db;
         Session session(db);
-        SellPage page(db, session);
+        RequestContext ctx(db, session);
+        SellPage page(ctx);
         return page.run();
     } catch (const std::exception& e) {
         std::cout << "Content-type: text/plain\n\n";
@@ -1,6 +1,7 @@
 // main_transactions.cpp
 #include "core/Database.hpp"
 #include "core/Session.hpp"
+#include "core/RequestContext.hpp"
 #include "pages/TransactionsPage.hpp"
 #include <iostream>
 
@@ -8,7 +9,8 @@ int main() {
     try {
         Database db;
         Session session(db);
-        TransactionsPage page(db, session);
+        RequestContext ctx(db, session);
+        TransactionsPage page(ctx);
         return page.run();
     }
     catch (const std::exception& e) {
@@ -0,0 +1,398 @@
+// pages/ApiPage.cpp
+#include "pages/ApiPage.hpp"
+#include "core/ActivityQuery.hpp"
+#include "core/BidPlacement.hpp"
+#include "core/Statement.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+ApiPage::ApiPage(RequestContext& ctx)
+    : Page(ctx), query_(ctx.arena()), json_(std::cout) {
+    if (const char* qs = std::getenv("QUERY_STRING")) {
+        query_.parse(qs);
+    }
+}
+
+// -------------------------------------------------------------
+// Headers / errors
+// -------------------------------------------------------------
+void ApiPage::sendJsonHeader(const char* status) const {
+    sendPositionCookie();
+    std::cout << "Status: " << status << "\r\n"
+              << "Content-Type: application/json\r\n"
+              << "Cache-Control: no-store\r\n\r\n";
+}
+
+void ApiPage::sendError(const char* status, std::string_view code, std::string_view message) {
+    sendJsonHeader(status);
+    json_.beginObject()
+        .key("error").string(code)
+        .key("message").string(message)
+        .endObject();
+    std::cout << "\n";
+}
+
+static bool parseLong(std::string_view text, long& out) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+long ApiPage::limitParam(long fallback) const {
+    long limit = fallback;
+    if (!parseLong(query_["limit"], limit) || limit <= 0) limit = fallback;
+    return limit > kMaxLimit ? kMaxLimit : limit;
+}
+
+static std::string_view routePath() {
+    const char* p = std::getenv("PATH_INFO");
+    std::string_view path = p ? p : "";
+    while (!path.empty() && path.back() == '/') path.remove_suffix(1);
+    return path;
+}
+
+// -------------------------------------------------------------
+// Routing
+// -------------------------------------------------------------
+void ApiPage::handleGet() {
+    std::string_view path = routePath();
+
+    if (path == "/items") {
+        listItems();
+        return;
+    }
+    if (path.substr(0, 7) == "/items/") {
+        long itemId = 0;
+        if (parseLong(path.substr(7), itemId) && itemId > 0) {
+            showItem(itemId);
+            return;
+        }
+    }
+    if (path == "/me/transactions") {
+        listTransactions();
+        return;
+    }
+    if (path == "/bids") {
+        sendError("405 Method Not Allowed", "method_not_allowed", "Use POST to place a bid.");
+        return;
+    }
+    sendError("404 Not Found", "not_found", "No such endpoint.");
+}
+
+void ApiPage::handlePost() {
+    if (routePath() == "/bids") {
+        placeBid();
+        return;
+    }
+    sendError("404 Not Found", "not_found", "No such endpoint.");
+}
+
+const char* const ApiPage::kItemsPageSql =
+    "SELECT i.item_id, i.title, u.user_email, i.seller_id, "
+    "       CAST(ROUND(COALESCE(wb.bid_amount, i.start_price)*100) AS SIGNED), "
+    "       UNIX_TIMESTAMP(i.start_time), UNIX_TIMESTAMP(i.end_time) "
+    "FROM items i "
+    "JOIN users u ON u.user_id = i.seller_id "
+    "LEFT JOIN bids wb ON wb.bid_id = i.winning_bid_id "
+    "WHERE i.item_id > ? AND i.end_time > FROM_UNIXTIME(?) "
+    "ORDER BY i.item_id ASC "
+    "LIMIT ?";
+
+// -------------------------------------------------------------
+// GET /items — unexpired items by id, keyset cursor = last id
+// -------------------------------------------------------------
+void ApiPage::listItems() {
+    long after = 0;
+    if (!query_["cursor"].empty() && (!parseLong(query_["cursor"], after) || after < 0)) {
+        sendError("400 Bad Request", "bad_cursor", "cursor must be an item id.");
+        return;
+    }
+    const long limit = limitParam(kDefaultLimit);
+
+    auto writeItem = [&](long id, std::string_view title, std::string_view seller, long sellerId,
+                         Money price, long long startEpoch, long long endEpoch) {
+        json_.beginObject()
+            .key("id").number(id)
+            .key("title").string(title)
+            .key("seller").string(seller)
+            .key("seller_id").number(sellerId)
+            .key("price").money(price)
+            .key("start").number(startEpoch)
+            .key("end").number(endEpoch)
+            .endObject();
+    };
+
+    long lastId = 0;
+    long written = 0;
+    bool more = false;
+    bool truncated = false;     // the row stream failed after the header went out
+
+    if (const auto* snapshot = ctx_.activeSnapshot()) {
+        // Snapshot is ordered by end time; page through it by id
+        std::pmr::vector<const ActiveItemsCache::Item*> rows(arena());
+        for (const auto& it : *snapshot)
+            if (it.id > after) rows.push_back(&it);
+        const std::size_t take = std::min<std::size_t>(rows.size(), static_cast<std::size_t>(limit) + 1);
+        std::partial_sort(rows.begin(), rows.begin() + take, rows.end(),
+            [](auto* a, auto* b) { return a->id < b->id; });
+
+        sendJsonHeader();
+        json_.beginObject().key("items").beginArray();
+        for (std::size_t i = 0; i < take; ++i) {
+            const auto* it = rows[i];
+            if (written == limit) { more = true; break; }
+            writeItem(it->id, it->title, it->sellerEmail, it->sellerId, it->current,
+                it->startEpoch, it->endEpoch);
+            lastId = it->id;
+            ++written;
+        }
+    }
+    else {
+        const char* sql = kItemsPageSql;
+
+        long long afterId = after, nowEpoch = static_cast<long long>(requestTime_), fetch = limit + 1;
+        MYSQL_BIND p[3]; std::memset(p, 0, sizeof(p));
+        p[0].buffer_type = MYSQL_TYPE_LONGLONG; p[0].buffer = &afterId;
+        p[1].buffer_type = MYSQL_TYPE_LONGLONG; p[1].buffer = &nowEpoch;
+        p[2].buffer_type = MYSQL_TYPE_LONGLONG; p[2].buffer = &fetch;
+
+        long id = 0, seller = 0;
+        char titleBuf[256]; unsigned long titleLen = 0;
+        char emailBuf[129]; unsigned long emailLen = 0;
+        long long cents = 0, startEpoch = 0, endEpoch = 0;
+
+        MYSQL_BIND r[7]; std::memset(r, 0, sizeof(r));
+        r[0].buffer_type = MYSQL_TYPE_LONG;     r[0].buffer = &id;     r[0].is_unsigned = 1;
+        r[1].buffer_type = MYSQL_TYPE_STRING;   r[1].buffer = titleBuf; r[1].buffer_length = sizeof(titleBuf); r[1].length = &titleLen;
+        r[2].buffer_type = MYSQL_TYPE_STRING;   r[2].buffer = emailBuf; r[2].buffer_length = sizeof(emailBuf); r[2].length = &emailLen;
+        r[3].buffer_type = MYSQL_TYPE_LONG;     r[3].buffer = &seller; r[3].is_unsigned = 1;
+        r[4].buffer_type = MYSQL_TYPE_LONGLONG; r[4].buffer = &cents;
+        r[5].buffer_type = MYSQL_TYPE_LONGLONG; r[5].buffer = &startEpoch;
+        r[6].buffer_type = MYSQL_TYPE_LONGLONG; r[6].buffer = &endEpoch;
+
+        Statement stmt(db_, sql, Database::Route::Replica);
+        if (!stmt.bindParams(p) || !stmt.execute(Statement::Fetch::Streaming) || !stmt.bindResult(r)) {
+            sendError("500 Internal Server Error", "query_failed", "Unable to load items.");
+            return;
+        }
+
+        sendJsonHeader();
+        json_.beginObject().key("items").beginArray();
+        while (stmt.fetch()) {
+            if (written == limit) { more = true; continue; }   // drain
+            writeItem(id,
+                std::string_view(titleBuf, titleLen < sizeof(titleBuf) ? titleLen : sizeof(titleBuf)),
+                std::string_view(emailBuf, emailLen < sizeof(emailBuf) ? emailLen : sizeof(emailBuf)),
+                seller, Money::fromCents(cents), startEpoch, endEpoch);
+            lastId = id;
+            ++written;
+        }
+        truncated = stmt.failed();
+    }
+
+    json_.endArray();
+    if (truncated) {
+        // Too late for a 500: flag the page instead of ending it
+        // with a "next": null that reads as the last page
+        json_.key("error").string("query_failed").endObject();
+        std::cout << "\n";
+        return;
+    }
+    json_.key("next");
+    if (more) {
+        char buf[24];
+        json_.string(std::string_view(buf, std::to_chars(buf, buf + sizeof(buf), lastId).ptr - buf));
+    } else {
+        json_.null();
+    }
+    json_.endObject();
+    std::cout << "\n";
+}
+
+// -------------------------------------------------------------
+// GET /items/{id} — one primary-key lookup
+// -------------------------------------------------------------
+void ApiPage::showItem(long itemId) {
+    const RequestContext::ItemState* item = ctx_.itemState(itemId);
+    if (!item) {
+        sendError("404 Not Found", "not_found", "No such item.");
+        return;
+    }
+
+    const Money floor = item->currentMaxBid > item->startPrice ? item->currentMaxBid : item->startPrice;
+    sendJsonHeader();
+    json_.beginObject()
+        .key("id").number(item->itemId)
+        .key("title").string(item->title)
+        .key("description").string(item->description)
+        .key("seller").string(item->sellerEmail)
+        .key("seller_id").number(item->sellerId)
+        .key("start_price").money(item->startPrice)
+        .key("current_bid");
+    if (item->currentMaxBid > Money()) json_.money(item->currentMaxBid);
+    else json_.null();
+    json_.key("price").money(floor)
+        .key("active").boolean(item->active)
+        .key("end").number(static_cast<long long>(item->endEpoch))
+        .endObject();
+    std::cout << "\n";
+}
+
+// -------------------------------------------------------------
+// POST /bids — same write path as bid.cgi
+// -------------------------------------------------------------
+void ApiPage::placeBid() {
+    long itemId = 0;
+    Money amount;
+    std::string_view amountText = postData_.contains("amount") ? postData_["amount"] : postData_["bid_amount"];
+
+    if (!parseLong(postData_["item_id"], itemId) || itemId <= 0) {
+        sendError("400 Bad Request", "bad_item_id", "item_id must be a positive integer.");
+        return;
+    }
+    if (!Money::parse(amountText, amount) || amount <= Money()) {
+        sendError("400 Bad Request", "bad_amount", "amount must be a positive price.");
+        return;
+    }
+
+    const BidPlacement::Result res = BidPlacement::place(ctx_, itemId, amount);
+    switch (res.outcome) {
+    case BidPlacement::Outcome::Placed:
+        sendJsonHeader("201 Created");
+        json_.beginObject()
+            .key("item_id").number(itemId)
+            .key("amount").money(amount)
+            .endObject();
+        std::cout << "\n";
+        return;
+    case BidPlacement::Outcome::NotLoggedIn:
+        sendError("401 Unauthorized", "not_logged_in", "Log in to place a bid.");
+        return;
+    case BidPlacement::Outcome::Throttled:
+        std::cout << "Retry-After: " << res.retryAfter << "\r\n";
+        sendError("429 Too Many Requests", "throttled", "Too many bids; retry later.");
+        return;
+    case BidPlacement::Outcome::NoSuchItem:
+        sendError("404 Not Found", "not_found", "No such item.");
+        return;
+    case BidPlacement::Outcome::OwnItem:
+        sendError("403 Forbidden", "own_item", "You cannot bid on your own item.");
+        return;
+    case BidPlacement::Outcome::NotActive:
+        sendError("409 Conflict", "not_active", "This auction is not currently active.");
+        return;
+    case BidPlacement::Outcome::TooLow:
+        sendJsonHeader("409 Conflict");
+        json_.beginObject()
+            .key("error").string("bid_too_low")
+            .key("message").string("Bid must be greater than the current price.")
+            .key("floor").money(res.floor)
+            .endObject();
+        std::cout << "\n";
+        return;
+    case BidPlacement::Outcome::Failed:
+        sendError("500 Internal Server Error", "failed", res.error);
+        return;
+    }
+}
+
+// -------------------------------------------------------------
+// GET /me/transactions — one section (with cursor) or the first
+// page of every section in one UNION ALL round trip
+// -------------------------------------------------------------
+void ApiPage::listTransactions() {
+    if (!ctx_.loggedIn()) {
+        sendError("401 Unauthorized", "not_logged_in", "Log in to see your transactions.");
+        return;
+    }
+
+    const ActivityQuery::Section* only = nullptr;
+    ActivityQuery::Cursor after;
+    const bool hasCursor = !query_["cursor"].empty();
+    if (!query_["section"].empty() && !(only = ActivityQuery::findSection(query_["section"]))) {
+        sendError("400 Bad Request", "bad_section", "section must be selling, purchases, bids or lost.");
+        return;
+    }
+    if (hasCursor && (!only || !ActivityQuery::parseCursor(query_["cursor"], after))) {
+        sendError("400 Bad Request", "bad_cursor", "cursor needs a section and the form <end>.<item_id>.");
+        return;
+    }
+
+    const long limit = limitParam(25);
+    const long userId = ctx_.userId();
+
+    std::pmr::string sql(arena());
+    ActivityQuery::Params params;
+    for (const ActivityQuery::Section* s : ActivityQuery::kSections) {
+        if (only && s != only) continue;
+        if (!sql.empty()) sql += " UNION ALL ";
+        ActivityQuery::appendSection(sql, params, *s, userId, requestTime_,
+            hasCursor ? &after : nullptr, static_cast<int>(limit) + 1);
+    }
+
+    // Per-section page state; rows stream out as they arrive
+    struct Progress {
+        long count = 0;
+        bool more = false;
+        ActivityQuery::Cursor last;
+    } progress[4];
+
+    bool started = false;
+    bool ok = ActivityQuery::scan(db_, sql, params, [&](const ActivityQuery::Row& r) {
+        if (!started) {
+            sendJsonHeader();
+            json_.beginObject().key("rows").beginArray();
+            started = true;
+        }
+        int i = 0;
+        while (i < 4 && r.section != ActivityQuery::kSections[i]->id) ++i;
+        if (i == 4) return;
+        Progress& p = progress[i];
+        if (p.count == limit) { p.more = true; return; }
+
+        json_.beginObject()
+            .key("section").string(r.section)
+            .key("item_id").number(r.itemId)
+            .key("title").string(r.title)
+            .key("end").number(r.endEpoch)
+            .key("leader");
+        if (r.hasWinner) json_.string(r.leader);
+        else json_.null();
+        json_.key("leading").boolean(r.hasWinner && r.winnerId == userId)
+            .key("top_bid").money(r.topBid)
+            .key("my_max").money(r.myMax)
+            .endObject();
+
+        p.last.endEpoch = r.endEpoch;
+        p.last.itemId = r.itemId;
+        ++p.count;
+    });
+
+    if (!ok && !started) {
+        sendError("500 Internal Server Error", "query_failed", "Unable to load transactions.");
+        return;
+    }
+    if (!started) {
+        sendJsonHeader();
+        json_.beginObject().key("rows").beginArray();
+    }
+    if (!ok) {
+        // Rows already sent: mark the page incomplete (no cursors)
+        json_.endArray().key("error").string("query_failed").endObject();
+        std::cout << "\n";
+        return;
+    }
+
+    json_.endArray().key("next").beginObject();
+    for (int i = 0; i < 4; ++i) {
+        const ActivityQuery::Section* s = ActivityQuery::kSections[i];
+        if (only && s != only) continue;
+        json_.key(s->id);
+        if (progress[i].more) json_.string(ActivityQuery::formatCursor(progress[i].last));
+        else json_.null();
+    }
+    json_.endObject().endObject();
+    std::cout << "\n";
+}
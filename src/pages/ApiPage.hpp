@@ -0,0 +1,45 @@
+// pages/ApiPage.hpp
+#pragma once
+
+#include "core/Page.hpp"
+#include "utils/FormData.hpp"
+#include "utils/JsonWriter.hpp"
+#include <string_view>
+
+// ------------------------------------------------------------------
+// ApiPage (api.cgi) — JSON over the same query layer as the pages
+//   GET  /api/items?cursor=<id>&limit=N         open + upcoming items
+//   GET  /api/items/{id}                         one item
+//   POST /api/bids        item_id, amount        place a bid (session)
+//   GET  /api/me/transactions[?section=S&cursor=<end>.<id>&limit=N]
+// The route is PATH_INFO (api.cgi/items/7; the web server maps
+// /api/* onto it). List responses carry "next": the cursor for
+// the following page, or null on the last one.
+// ------------------------------------------------------------------
+class ApiPage : public Page {
+public:
+    explicit ApiPage(RequestContext& ctx);
+
+    // GET /items page query (checked by make plan-test)
+    static const char* const kItemsPageSql;
+
+protected:
+    void handleGet() override;
+    void handlePost() override;
+
+private:
+    static constexpr long kDefaultLimit = 50;
+    static constexpr long kMaxLimit = 100;
+
+    FormData query_;
+    JsonWriter json_;
+
+    void listItems();
+    void showItem(long itemId);
+    void placeBid();
+    void listTransactions();
+
+    void sendJsonHeader(const char* status = "200 OK") const;
+    void sendError(const char* status, std::string_view code, std::string_view message);
+    long limitParam(long fallback) const;
+};
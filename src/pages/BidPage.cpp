@@ -1,130 +1,52 @@
 // pages/BidPage.cpp
 #include "pages/BidPage.hpp"
+#include "core/BidPlacement.hpp"
 #include "utils/utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
 #include <stdexcept>
 #include <cstdio>
 
-BidPage::BidPage(Database& db, Session& session)
-    : Page(db, session) {}
-
-
-// -------------------------------------------------------------
-// Helper: fetch active items, excluding the current user's own
-// -------------------------------------------------------------
-
-std::vector<BidPage::ItemOption> BidPage::fetchActiveItemsExcludingSeller(long excludeSellerId) {
-    std::vector<ItemOption> items;
-    MYSQL* conn = db_.connection();
-    if (!conn) return items;
-
-    const char* sql =
-        "SELECT i.item_id, i.title "
-        "FROM items i "
-        "WHERE i.start_time <= NOW() "
-        "  AND i.end_time > NOW() "
-        "  AND (? <= 0 OR i.seller_id <> ?) "
-        "ORDER BY i.end_time ASC, i.title ASC";
-
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (!stmt) return items;
-
-    if (mysql_stmt_prepare(stmt, sql, std::strlen(sql)) != 0) {
-        mysql_stmt_close(stmt);
-        return items;
-    }
-
-    MYSQL_BIND p[2]; std::memset(p, 0, sizeof(p));
-    long ex = excludeSellerId;
-    p[0].buffer_type = MYSQL_TYPE_LONG; p[0].buffer = &ex; p[0].is_unsigned = 1;
-    p[1].buffer_type = MYSQL_TYPE_LONG; p[1].buffer = &ex; p[1].is_unsigned = 1;
-
-    mysql_stmt_bind_param(stmt, p);
-    if (mysql_stmt_execute(stmt) != 0) {
-        mysql_stmt_close(stmt);
-        return items;
-    }
-
-    long idBuf = 0;
-    char titleBuf[256]{};
-    unsigned long titleLen = 0;
-
-    MYSQL_BIND r[2]; std::memset(r, 0, sizeof(r));
-    r[0].buffer_type = MYSQL_TYPE_LONG;   r[0].buffer = &idBuf;   r[0].is_unsigned = 1;
-    r[1].buffer_type = MYSQL_TYPE_STRING; r[1].buffer = titleBuf; r[1].buffer_length = sizeof(titleBuf); r[1].length = &titleLen;
-
-    mysql_stmt_bind_result(stmt, r);
-    while (mysql_stmt_fetch(stmt) == 0) {
-        ItemOption opt; opt.id = idBuf; opt.title.assign(titleBuf, titleLen);
-        items.push_back(opt);
+// Percent-encode a query value for the pager links
+static void appendUrlEncoded(std::pmr::string& out, std::string_view in) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (unsigned char c : in) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out += static_cast<char>(c);
+        } else {
+            out += '%';
+            out += hex[c >> 4];
+            out += hex[c & 0xF];
+        }
     }
-    mysql_stmt_close(stmt);
-    return items;
 }
 
+BidPage::BidPage(RequestContext& ctx)
+    : Page(ctx), query_(ctx.arena()) {}
+
 // -------------------------------------------------------------
-// Helper: load seller, start price, current max bid, active flag
+// Positive decimal item id, else 0
 // -------------------------------------------------------------
-bool BidPage::loadItemAndState(long itemId,
-    long& sellerId,
-    double& startPrice,
-    double& currentMaxBid,
-    bool& isActive) {
-    MYSQL* conn = db_.connection();
-    if (!conn) return false;
-
-    const char* sql =
-        "SELECT i.seller_id, i.start_price, "
-        "       IFNULL((SELECT MAX(b.bid_amount) FROM bids b WHERE b.item_id=i.item_id), 0) AS max_bid, "
-        "       (NOW() BETWEEN i.start_time AND i.end_time) AS is_active "
-        "FROM items i WHERE i.item_id=? LIMIT 1";
-
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (!stmt) return false;
-
-    if (mysql_stmt_prepare(stmt, sql, std::strlen(sql)) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
-    MYSQL_BIND p{}; std::memset(&p, 0, sizeof(p));
-    p.buffer_type = MYSQL_TYPE_LONG; p.buffer = &itemId; p.is_unsigned = 1;
-    mysql_stmt_bind_param(stmt, &p);
-
-    long seller = 0; double start = 0, maxBid = 0; int active = 0;
-
-    MYSQL_BIND r[4]; std::memset(r, 0, sizeof(r));
-    r[0].buffer_type = MYSQL_TYPE_LONG;   r[0].buffer = &seller; r[0].is_unsigned = 1;
-    r[1].buffer_type = MYSQL_TYPE_DOUBLE; r[1].buffer = &start;
-    r[2].buffer_type = MYSQL_TYPE_DOUBLE; r[2].buffer = &maxBid;
-    r[3].buffer_type = MYSQL_TYPE_LONG;   r[3].buffer = &active;
-
-    mysql_stmt_bind_result(stmt, r);
-    bool ok = (mysql_stmt_execute(stmt) == 0) && (mysql_stmt_fetch(stmt) == 0);
-    mysql_stmt_close(stmt);
-    if (!ok) return false;
-
-    sellerId = seller;
-    startPrice = start;
-    currentMaxBid = maxBid;
-    isActive = (active != 0);
-    return true;
+long BidPage::parseItemId(std::string_view text) {
+    long id = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), id);
+    return (ec == std::errc() && ptr == text.data() + text.size() && id > 0) ? id : 0;
 }
 
-
-
-
-
-
 // -------------------------------------------------------------
 // GET — render form (excludes user’s own items if logged in)
 // -------------------------------------------------------------
 void BidPage::handleGet() {
-    long exclude = session_.validate() ? session_.userId() : 0;
-    auto items = fetchActiveItemsExcludingSeller(exclude);
-    renderForm(items);
+    // ?item_id=N selects the single-item view; q/page drive the picker
+    if (const char* qs = std::getenv("QUERY_STRING")) {
+        query_.parse(qs);
+    }
+    viewItemId_ = parseItemId(query_["item_id"]);
+    renderForm();
 }
 
 // -------------------------------------------------------------
@@ -132,196 +54,77 @@ void BidPage::handleGet() {
 // -------------------------------------------------------------
 void BidPage::handlePost() {
     // Page::run() has already filled postData_ for POST.
-    if (!session_.validate()) {
-        auto items = fetchActiveItemsExcludingSeller(0);
-        renderForm(items, "You must be logged in to place a bid.");
-        return;
+    // Posted from the single-item view: errors re-render that view.
+    if (postData_["view"] == "item") {
+        viewItemId_ = parseItemId(postData_["item_id"]);
     }
 
-    long userId = session_.userId();
+    if (!ctx_.loggedIn()) {
+        renderForm("You must be logged in to place a bid.");
+        return;
+    }
 
-    std::string itemIdStr = postData_["item_id"];
-    std::string amountStr = postData_["bid_amount"];
+    std::string itemIdStr(postData_["item_id"]);
+    std::string amountStr(postData_["bid_amount"]);
     long itemId = 0;
-    double amount = 0.0;
+    Money amount;
 
     // Basic input validation
-    char* endp = nullptr;
-    if (itemIdStr.empty() || (itemId = std::strtol(itemIdStr.c_str(), &endp, 10)) <= 0 || *endp != '\0') {
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "Please select a valid item.", "", 0, amountStr);
+    if ((itemId = parseItemId(itemIdStr)) <= 0) {
+        renderForm("Please select a valid item.", "", 0, amountStr);
         return;
     }
-    try {
-        size_t pos = 0;
-        amount = std::stod(amountStr, &pos);
-        if (pos != amountStr.size() || amount <= 0.0) throw std::runtime_error("bad");
-    }
-    catch (...) {
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "Enter a valid positive bid amount.", "", itemId, amountStr);
+    if (!Money::parse(amountStr, amount) || amount <= Money()) {
+        renderForm("Enter a valid positive bid amount.", "", itemId, amountStr);
         return;
     }
 
-    // Load item state
-    long sellerId = 0; double startPrice = 0.0; double currentMax = 0.0; bool isActive = false;
-    if (!loadItemAndState(itemId, sellerId, startPrice, currentMax, isActive)) {
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "Selected item does not exist.", "", 0, amountStr);
+    const BidPlacement::Result res = BidPlacement::place(ctx_, itemId, amount);
+    switch (res.outcome) {
+    case BidPlacement::Outcome::Placed:
+        break;
+    case BidPlacement::Outcome::NotLoggedIn:
+        renderForm("You must be logged in to place a bid.");
         return;
-    }
-
-    // Business rules
-    if (sellerId == userId) {
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "You cannot bid on your own item.", "", itemId, amountStr);
+    case BidPlacement::Outcome::Throttled:
+        sendRetryLater("429 Too Many Requests", res.retryAfter,
+            "Lots of bids are coming in right now. Please try again in a moment.");
         return;
-    }
-    if (!isActive) {
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "This auction is not currently active.", "", itemId, amountStr);
+    case BidPlacement::Outcome::NoSuchItem:
+        renderForm("Selected item does not exist.", "", 0, amountStr);
         return;
-    }
-
-    double floor = (currentMax > startPrice ? currentMax : startPrice);
-    if (amount <= floor) {
-        char msg[160];
-        std::snprintf(msg, sizeof(msg),
-            "Your bid must be greater than the current highest bid (or start price): $%.2f.",
-            floor);
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, msg, "", itemId, amountStr);
+    case BidPlacement::Outcome::OwnItem:
+        renderForm("You cannot bid on your own item.", "", itemId, amountStr);
         return;
-    }
-
-    // Insert bid
-    // use existing DB connection
-    MYSQL* conn = db_.connection();
-    if (!conn) {
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "Database connection failed. Please try again.", "", itemId, amountStr);
+    case BidPlacement::Outcome::NotActive:
+        renderForm("This auction is not currently active.", "", itemId, amountStr);
         return;
-    }
-
-    const char* sql =
-        "INSERT INTO bids (item_id, bidder_id, bid_amount, bid_time) "
-        "VALUES (?, ?, ?, NOW())";
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (!stmt || mysql_stmt_prepare(stmt, sql, std::strlen(sql)) != 0) {
-        if (stmt) mysql_stmt_close(stmt);
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "Internal error. Please try again.", "", itemId, amountStr);
+    case BidPlacement::Outcome::TooLow:
+        renderForm("Your bid must be greater than the current highest bid (or start price): $"
+            + res.floor.str() + ".", "", itemId, amountStr);
         return;
-    }
-
-    MYSQL_BIND bp[3]; std::memset(bp, 0, sizeof(bp));
-    bp[0].buffer_type = MYSQL_TYPE_LONG;   bp[0].buffer = &itemId; bp[0].is_unsigned = 1;
-    bp[1].buffer_type = MYSQL_TYPE_LONG;   bp[1].buffer = &userId; bp[1].is_unsigned = 1;
-    bp[2].buffer_type = MYSQL_TYPE_DOUBLE; bp[2].buffer = &amount;
-
-    if (mysql_stmt_bind_param(stmt, bp) != 0 || mysql_stmt_execute(stmt) != 0) {
-        std::string err = mysql_stmt_error(stmt);
-        mysql_stmt_close(stmt);
-        auto items = fetchActiveItemsExcludingSeller(userId);
-        renderForm(items, "Failed to place bid: " + err, "", itemId, amountStr);
+    case BidPlacement::Outcome::Failed:
+        renderForm("Failed to place bid: " + res.error, "", itemId, amountStr);
         return;
     }
-    mysql_stmt_close(stmt);
-
-    //
-    // Update for items table
-    //
-    // 1) Find current top bid for this item
-    const char* sqlTop =
-        "SELECT bid_id, bidder_id "
-        "FROM bids "
-        "WHERE item_id = ? "
-        "ORDER BY bid_amount DESC, bid_time ASC "
-        "LIMIT 1";
-
-    MYSQL_STMT* topStmt = mysql_stmt_init(conn);
-    if (topStmt && mysql_stmt_prepare(topStmt, sqlTop, std::strlen(sqlTop)) == 0) {
-        MYSQL_BIND topParam[1];
-        std::memset(topParam, 0, sizeof(topParam));
-        topParam[0].buffer_type = MYSQL_TYPE_LONG;
-        topParam[0].buffer = &itemId;
-        topParam[0].is_unsigned = 1;
-        mysql_stmt_bind_param(topStmt, topParam);
-
-        long topBidId = 0;
-        long topBidderId = 0;
-
-        MYSQL_BIND topRes[2];
-        std::memset(topRes, 0, sizeof(topRes));
-        topRes[0].buffer_type = MYSQL_TYPE_LONG;
-        topRes[0].buffer = &topBidId;
-        topRes[0].is_unsigned = 1;
-        topRes[1].buffer_type = MYSQL_TYPE_LONG;
-        topRes[1].buffer = &topBidderId;
-        topRes[1].is_unsigned = 1;
-        mysql_stmt_bind_result(topStmt, topRes);
-
-        if (mysql_stmt_execute(topStmt) == 0 &&
-            mysql_stmt_fetch(topStmt) == 0 &&
-            topBidId > 0 && topBidderId > 0) {
-
-            mysql_stmt_close(topStmt);
-
-            // 2) Update items with current leading bid + bidder
-            const char* sqlUpdate =
-                "UPDATE items "
-                "SET winning_bid_id = ?, winner_id = ? "
-                "WHERE item_id = ?";
-
-            MYSQL_STMT* upStmt = mysql_stmt_init(conn);
-            if (upStmt && mysql_stmt_prepare(upStmt, sqlUpdate, std::strlen(sqlUpdate)) == 0) {
-                MYSQL_BIND upParam[3];
-                std::memset(upParam, 0, sizeof(upParam));
-
-                upParam[0].buffer_type = MYSQL_TYPE_LONG;
-                upParam[0].buffer = &topBidId;
-                upParam[0].is_unsigned = 1;
-
-                upParam[1].buffer_type = MYSQL_TYPE_LONG;
-                upParam[1].buffer = &topBidderId;
-                upParam[1].is_unsigned = 1;
-
-                upParam[2].buffer_type = MYSQL_TYPE_LONG;
-                upParam[2].buffer = &itemId;
-                upParam[2].is_unsigned = 1;
-
-                mysql_stmt_bind_param(upStmt, upParam);
-                mysql_stmt_execute(upStmt);
-            }
-            if (upStmt) mysql_stmt_close(upStmt);
-        }
-        else {
-            mysql_stmt_close(topStmt);
-        }
-    }
-    else if (topStmt) {
-        mysql_stmt_close(topStmt);
-    }
 
-    // (Optional) You could refresh items and show success
-    auto items = fetchActiveItemsExcludingSeller(userId);
-    char ok[128]; std::snprintf(ok, sizeof(ok), "Your bid of $%.2f has been placed.", amount);
-    renderForm(items, "", ok);
+    // A bid does not change which items are open, so the
+    // memoized list is still the right one to show.
+    renderForm("", "Your bid of $" + amount.str() + " has been placed.");
 }
 
 
 // -------------------------------------------------------------
-// Shared renderer
+// Shared renderer: banner + flash, then item view or picker
 // -------------------------------------------------------------
-void BidPage::renderForm(const std::vector<ItemOption>& items,
-    const std::string& flashError,
+void BidPage::renderForm(const std::string& flashError,
     const std::string& flashSuccess,
     long selectedItemId,
     const std::string& enteredAmount) {
     sendHTMLHeader();
     printHead("Place a Bid · Team Elevate Auctions");
 
-    const bool loggedIn = session_.validate();
+    const bool loggedIn = ctx_.loggedIn();
     if (!loggedIn) {
         std::cout << R"(<div class="error" role="alert">
           You must be logged in to place a bid.
@@ -330,7 +133,7 @@ void BidPage::renderForm(const std::vector<ItemOption>& items,
     }
     else {
         std::cout << "  <div class='success' role='status'>Logged in as <strong>"
-            << htmlEscape(session_.userEmail()) << "</strong></div>\n";
+            << htmlEscape(ctx_.userEmail()) << "</strong></div>\n";
     }
 
     if (!flashError.empty()) {
@@ -342,23 +145,135 @@ void BidPage::renderForm(const std::vector<ItemOption>& items,
             << htmlEscape(flashSuccess) << "</div>\n";
     }
 
+    const RequestContext::ItemState* item =
+        viewItemId_ > 0 ? ctx_.itemState(viewItemId_) : nullptr;
+    if (item) {
+        renderItemView(*item, enteredAmount);
+    }
+    else {
+        if (viewItemId_ > 0) {
+            std::cout << "  <div class='error' role='alert'>That item could not be found.</div>\n";
+        }
+        renderPicker(selectedItemId, enteredAmount);
+    }
+    printTail();
+}
+
+// -------------------------------------------------------------
+// Single-item view (bid.cgi?item_id=N): one primary-key lookup
+// -------------------------------------------------------------
+void BidPage::renderItemView(const RequestContext::ItemState& item,
+    const std::string& enteredAmount) {
+    const bool loggedIn = ctx_.loggedIn();
+    const bool ownItem = loggedIn && ctx_.userId() == item.sellerId;
+    const Money floor = item.currentMaxBid > item.startPrice ? item.currentMaxBid : item.startPrice;
+    const bool hasBids = item.currentMaxBid > Money();
+
+    std::cout << "<section class=\"card\" aria-labelledby=\"bid-heading\" data-item=\""
+        << item.itemId << "\">\n"
+        << "  <h2 id=\"bid-heading\" style=\"margin-top:0;\">";
+    htmlEscape(std::cout, item.title);
+    std::cout << "</h2>\n"
+        << "  <p class=\"helper\">Sold by ";
+    htmlEscape(std::cout, item.sellerEmail);
+    std::cout << "</p>\n";
+
+    if (!item.description.empty()) {
+        std::cout << "  <p style=\"white-space:pre-line;\">";
+        htmlEscape(std::cout, item.description);
+        std::cout << "</p>\n";
+    }
+
+    std::cout << "  <p><strong><span class='js-leader'>" << (hasBids ? "Current bid" : "Starting price")
+        << "</span>:</strong> $<span class='js-price'>" << floor << "</span><br>\n"
+        << "  <strong>Time left:</strong> <time class='countdown' data-end='"
+        << static_cast<long long>(item.endEpoch) << "'></time></p>\n";
+
+    if (!item.active) {
+        std::cout << "  <div class=\"muted\">This auction is not currently open for bids.</div>\n";
+    }
+    else if (ownItem) {
+        std::cout << "  <div class=\"muted\">This is your listing; you cannot bid on it.</div>\n";
+    }
+    else {
+        std::cout << R"(
+  <form method="post" action="bid.cgi" novalidate>
+    <input type="hidden" name="view" value="item">
+    <input type="hidden" name="item_id" value=")" << item.itemId << R"(">
+
+    <label for="bidAmount">Your highest bid (more than $<span class='js-price'>)" << floor << R"(</span>)</label>
+    <input id="bidAmount" name="bid_amount" type="number" inputmode="decimal"
+           step="0.01" min="0.01" placeholder="0.00" required
+           value=")" << htmlEscape(enteredAmount) << R"(" >
+
+    <div style="display:flex; gap:10px; margin-top:16px;">
+      <button class='btn primary' type='submit')" << (loggedIn ? "" : " disabled") << R"(>Place Bid</button>
+      <a class='btn' href='browse.cgi' style='border:1px solid var(--border); background:#fff;'>Back to auctions</a>
+    </div>
+  </form>
+)";
+    }
+
+    std::cout << "  <p class=\"helper\" style=\"margin-bottom:0;\"><a href=\"bid.cgi\">Bid on a different item</a></p>\n"
+        << "</section>\n";
+    printCountdownScript();
+    printLiveScript();
+}
+
+// -------------------------------------------------------------
+// Fallback picker: searchable, one page of the dropdown at a time
+// -------------------------------------------------------------
+void BidPage::renderPicker(long selectedItemId, const std::string& enteredAmount) {
+    const bool loggedIn = ctx_.loggedIn();
+
+    // ?q= narrows by title (case-insensitive), ?page= picks the slice;
+    // a page number that is not a number (or overflows) means the
+    // first page, one past the end the last
+    std::string_view q = query_["q"];
+    std::size_t page = 0;
+    {
+        std::string_view pv = query_["page"];
+        auto [ptr, ec] = std::from_chars(pv.data(), pv.data() + pv.size(), page);
+        if (ec != std::errc() || ptr != pv.data() + pv.size()) page = 0;
+    }
+
+    std::pmr::vector<RequestContext::ItemOption> shown(arena());
+    const std::size_t total = ctx_.activeItemsPage(ctx_.userId(), q, page, kPickerPageSize, shown);
+
+    // Keep an explicitly selected item in the list after a failed POST
+    if (selectedItemId > 0 &&
+        std::none_of(shown.begin(), shown.end(), [&](const auto& it) { return it.id == selectedItemId; })) {
+        const RequestContext::ItemState* sel = ctx_.itemState(selectedItemId);
+        if (sel && sel->active && sel->sellerId != ctx_.userId())
+            shown.insert(shown.begin(), RequestContext::ItemOption{ sel->itemId, std::pmr::string(sel->title, arena()) });
+    }
+
     std::cout << R"(
 <section class="card" aria-labelledby="bid-heading">
   <h2 id="bid-heading" style="margin-top:0;">Bid on an Item</h2>
   <p class="helper">
     Choose an active listing and enter your highest bid.
-    You cannot bid on your own items.
+    You cannot bid on your own items. Tip: use <a href="browse.cgi">Browse Auctions</a>
+    and the Bid button on a row to go straight to that item.
   </p>
+
+  <form method="get" action="bid.cgi" style="display:flex; gap:10px; margin-bottom:12px;">
+    <input type="search" name="q" placeholder="Search items..." aria-label="Search items"
+           style="flex:1; padding:10px 12px; border:1px solid var(--border); border-radius:12px;"
+           value=")";
+    htmlEscape(std::cout, q);
+    std::cout << R"(">
+    <button type="submit" class="btn ghost">Search</button>
+  </form>
 )";
 
-    if (items.empty()) {
+    if (shown.empty()) {
         std::cout << R"(
   <div class="muted">
     There are no eligible items available to bid on right now.
   </div>
 </section>
 )";
-        printTail();
         return;
     }
 
@@ -371,12 +286,14 @@ void BidPage::renderForm(const std::vector<ItemOption>& items,
       <option value="">Select an item…</option>
 )";
 
-    for (const auto& it : items) {
+    for (const auto& it : shown) {
         std::cout << "      <option value='" << it.id << "'";
         if (selectedItemId == it.id) {
             std::cout << " selected";
         }
-        std::cout << ">" << htmlEscape(it.title) << "</option>\n";
+        std::cout << ">";
+        htmlEscape(std::cout, it.title);
+        std::cout << "</option>\n";
     }
 
     std::cout << R"(
@@ -407,7 +324,22 @@ void BidPage::renderForm(const std::vector<ItemOption>& items,
 
     std::cout << R"(
   </form>
-</section>
 )";
-    printTail();
+
+    // Pager (keeps the search term)
+    const std::size_t pages = (total + kPickerPageSize - 1) / kPickerPageSize;
+    if (pages > 1) {
+        std::pmr::string qEnc(arena());
+        appendUrlEncoded(qEnc, q);
+        std::cout << "  <p class=\"helper\">Page " << (page + 1) << " of " << pages << " · ";
+        if (page > 0) {
+            std::cout << "<a href='bid.cgi?q=" << qEnc << "&amp;page=" << (page - 1) << "'>Previous</a> ";
+        }
+        if (page + 1 < pages) {
+            std::cout << "<a href='bid.cgi?q=" << qEnc << "&amp;page=" << (page + 1) << "'>Next</a>";
+        }
+        std::cout << "</p>\n";
+    }
+
+    std::cout << "</section>\n";
 }
@@ -5,48 +5,50 @@
 #define PAGES_BIDPAGE_HPP
 
 #include "core/Page.hpp"
+#include "utils/FormData.hpp"
+#include <cstddef>
 #include <string>
-#include <vector>
+#include <string_view>
 
 // ------------------------------------------------------------------
 // BidPage
-// - Pure-UI item detail + place-bid template
+// - bid.cgi?item_id=N: single item detail + place-bid form
+// - bid.cgi[?q=...&page=N]: searchable, paginated item picker
 // - Uses shared header/footer (Page::printHead / printTail)
 // - Backend hookup points are documented in BidPage.cpp
 // ------------------------------------------------------------------
 class BidPage : public Page {
 public:
-    BidPage(Database& db, Session& session);
+    BidPage(RequestContext& ctx);
 
     // Renders the bid page UI
     void handleGet() override;
 
-    // Handles a POSTed bid amount (stub UI only; no DB writes yet)
+    // Places a POSTed bid through BidPlacement, then re-renders
     void handlePost() override;
 
 private:
-    // Special struct for handling bid items and their id/names
-    struct ItemOption{
-        long id;
-        std::string title;
-    };
-    
-    // For active items
-    std::vector<ItemOption> fetchActiveItemsExcludingSeller(long excludeSellerId);
-
-    // Load seller_id, start_price, current_max_bid, and whether auction is active
-    bool loadItemAndState(long itemId,
-        long& sellerId,
-        double& startPrice,
-        double& currentMaxBid,
-        bool& isActive);
-
-    // Shared renderer used by GET and POST (preserves entered values / flash)
-    void renderForm(const std::vector<ItemOption>& items,
-        const std::string& flashError = "",
+    static constexpr std::size_t kPickerPageSize = 50;
+
+    // Parsed QUERY_STRING (GET only)
+    FormData query_;
+
+    // Item shown in single-item view (0 = picker)
+    long viewItemId_ = 0;
+
+    static long parseItemId(std::string_view text);
+
+    // Shared renderer used by GET and POST (preserves entered values / flash).
+    // Item list and login state come from the request context, so
+    // every error path reuses the same lookups.
+    void renderForm(const std::string& flashError = "",
         const std::string& flashSuccess = "",
         long selectedItemId = 0,
         const std::string& enteredAmount = "");
+
+    void renderItemView(const RequestContext::ItemState& item,
+        const std::string& enteredAmount);
+    void renderPicker(long selectedItemId, const std::string& enteredAmount);
 };
 
 #endif // PAGES_BIDPAGE_HPP
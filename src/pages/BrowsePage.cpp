@@ -1,10 +1,10 @@
 #include "pages/BrowsePage.hpp"
+#include "core/Statement.hpp"
 #include "utils/utils.hpp"
+#include "utils/Money.hpp"
 
+#include <algorithm>
 #include <iostream>
-#include <iomanip>
-#include <sstream>
-#include <ctime>
 #include <cstring>
 #include <cstdlib>
 
@@ -63,80 +63,103 @@ static void parseQueryString(std::string& qParam, std::string& sortParam) {
 }
 
 // -------------------------------------------------------------
-// Helper: format currency as $12.34
+// Rows rendered between response flushes
 // -------------------------------------------------------------
-static std::string formatCurrency(double amount) {
-    std::ostringstream oss;
-    oss.setf(std::ios::fixed, std::ios::floatfield);
-    oss << std::setprecision(2) << amount;
-    std::string value = oss.str();
-    return std::string("$") + value;
+static constexpr int kFlushEvery = 64;
+
+// -------------------------------------------------------------
+// One listing row (shared by the snapshot and query paths)
+// -------------------------------------------------------------
+void BrowsePage::renderRow(long itemId,
+    std::string_view title,
+    std::string_view sellerEmail,
+    long sellerId,
+    Money currentBid,
+    long long endEpoch,
+    long currentUserId) {
+    bool canBid =
+        currentUserId > 0 &&
+        currentUserId != sellerId;
+
+    std::cout << "          <tr data-item='" << itemId << "'>\n";
+
+    // Item: link to bid page for that item
+    std::cout << "            <td>";
+    std::cout << "<a href='bid.cgi?item_id="
+        << itemId
+        << "'>";
+    htmlEscape(std::cout, title);
+    std::cout << "</a>";
+    std::cout << "</td>\n";
+
+    // Seller
+    std::cout << "            <td>";
+    htmlEscape(std::cout, sellerEmail);
+    std::cout << "</td>\n";
+
+    // Current bid (+ optional Bid button)
+    std::cout << "            <td>$<span class='js-price'>"
+        << currentBid << "</span>";
+    if (canBid) {
+        std::cout << "  ";
+        std::cout << "<a class='btn primary' "
+            "style='margin-left:6px; display:inline-block;"
+            "vertical-align:middle;' "
+            "href='bid.cgi?item_id="
+            << itemId
+            << "'>Bid</a>";
+    }
+
+    std::cout << "</td>\n";
+
+    // Time left (ticked client-side from the end epoch)
+    std::cout << "            <td><time class='countdown' data-end='"
+        << endEpoch
+        << "'></time></td>\n";
+
+    std::cout << "          </tr>\n";
 }
 
 // -------------------------------------------------------------
-// Helper: format remaining time until end_time as a short string
-// Uses server local time via std::time / std::mktime.
+// Listing query for the direct (no snapshot) path: binds are
+// now, then the LIKE pattern twice when searching
 // -------------------------------------------------------------
-static std::string formatTimeLeft(const MYSQL_TIME& endTime) {
-    std::tm tmEnd;
-    std::memset(&tmEnd, 0, sizeof(tmEnd));
-
-    tmEnd.tm_year = static_cast<int>(endTime.year) - 1900;
-    tmEnd.tm_mon = static_cast<int>(endTime.month) - 1;
-    tmEnd.tm_mday = static_cast<int>(endTime.day);
-    tmEnd.tm_hour = static_cast<int>(endTime.hour);
-    tmEnd.tm_min = static_cast<int>(endTime.minute);
-    tmEnd.tm_sec = static_cast<int>(endTime.second);
-
-    std::time_t endT = std::mktime(&tmEnd);
-    std::time_t nowT = std::time(NULL);
-
-    if (endT <= nowT) {
-        return "Ended";
+void BrowsePage::appendListingSql(std::pmr::string& sql, bool hasSearch, std::string_view sortKey) {
+    // Base query
+    sql +=
+        "SELECT i.item_id, i.title, u.user_email, i.seller_id, "
+        "       CAST(ROUND(COALESCE(MAX(b.bid_amount), i.start_price)*100) AS SIGNED) AS current_bid, "
+        "       UNIX_TIMESTAMP(i.end_time) AS end_epoch "
+        "FROM items i "
+        "JOIN users u ON i.seller_id = u.user_id "
+        "LEFT JOIN bids b ON b.item_id = i.item_id "
+        "WHERE i.end_time > FROM_UNIXTIME(?)";
+
+    if (hasSearch) {
+        sql += " AND (i.title LIKE ? OR i.description LIKE ?)";
     }
 
-    long diff = static_cast<long>(endT - nowT);
-    long days = diff / 86400;
-    diff = diff % 86400;
-    long hours = diff / 3600;
-    diff = diff % 3600;
-    long minutes = diff / 60;
-    long seconds = diff % 60;
-
-    std::ostringstream oss;
-
-    if (days > 0) {
-        // Example: "2d 03h"
-        oss << days << "d ";
-        if (hours < 10) {
-            oss << "0";
-        }
-        oss << hours << "h";
+    sql += " GROUP BY i.item_id, i.title, u.user_email, i.seller_id, i.start_price, i.end_time ";
+
+    if (sortKey == "newest") {
+        sql += "ORDER BY i.start_time DESC";
+    }
+    else if (sortKey == "low") {
+        sql += "ORDER BY current_bid ASC";
+    }
+    else if (sortKey == "high") {
+        sql += "ORDER BY current_bid DESC";
     }
     else {
-        // Example: "03:14:07"
-        if (hours < 10) {
-            oss << "0";
-        }
-        oss << hours << ":";
-        if (minutes < 10) {
-            oss << "0";
-        }
-        oss << minutes << ":";
-        if (seconds < 10) {
-            oss << "0";
-        }
-        oss << seconds;
+        sql += "ORDER BY i.end_time ASC";
     }
-
-    return oss.str();
 }
 
 // -------------------------------------------------------------
 // BrowsePage
 // -------------------------------------------------------------
-BrowsePage::BrowsePage(Database& db, Session& session)
-    : Page(db, session) {
+BrowsePage::BrowsePage(RequestContext& ctx)
+    : Page(ctx) {
 }
 
 // -------------------------------------------------------------
@@ -146,8 +169,7 @@ void BrowsePage::handleGet() {
     sendHTMLHeader();
     printHead("Browse Auctions · Team Elevate Auctions");
 
-    bool isLoggedIn = session_.isLoggedIn();
-    long currentUserId = session_.userId();
+    long currentUserId = ctx_.userId();
 
     // ---------------------------------------------------------
     // Read query parameters q (search) and sort
@@ -259,163 +281,136 @@ void BrowsePage::handleGet() {
     // ---------------------------------------------------------
     // unexpired auctions with optional search/sort
     // ---------------------------------------------------------
-    MYSQL* conn = db_.connection();
-    if (conn) {
-        // Base query
-        std::string sql =
-            "SELECT i.item_id, i.title, u.user_email, i.seller_id, "
-            "       COALESCE(MAX(b.bid_amount), i.start_price) AS current_bid, "
-            "       i.end_time "
-            "FROM items i "
-            "JOIN users u ON i.seller_id = u.user_id "
-            "LEFT JOIN bids b ON b.item_id = i.item_id "
-            "WHERE i.end_time > NOW()";
-
-        bool hasSearch = (searchTerm.size() > 0);
-        if (hasSearch) {
-            sql += " AND (i.title LIKE ? OR i.description LIKE ?)";
-        }
+    const bool hasSearch = (searchTerm.size() > 0);
+    const auto* snapshot = hasSearch ? nullptr : ctx_.activeSnapshot();
 
-        sql += " GROUP BY i.item_id, i.title, u.user_email, i.seller_id, i.start_price, i.end_time ";
+    MYSQL* conn = db_.connection();
+    if (snapshot) {
+        // Unsearched listing comes from the shared snapshot (already
+        // ordered by end time); other sorts reorder pointers into it.
+        std::pmr::vector<const ActiveItemsCache::Item*> rows(arena());
+        rows.reserve(snapshot->size());
+        for (const auto& it : *snapshot)
+            rows.push_back(&it);
 
         if (sortKey == "newest") {
-            sql += "ORDER BY i.start_time DESC";
+            std::stable_sort(rows.begin(), rows.end(),
+                [](auto* a, auto* b) { return a->startEpoch > b->startEpoch; });
         }
         else if (sortKey == "low") {
-            sql += "ORDER BY current_bid ASC";
+            std::stable_sort(rows.begin(), rows.end(),
+                [](auto* a, auto* b) { return a->current < b->current; });
         }
         else if (sortKey == "high") {
-            sql += "ORDER BY current_bid DESC";
+            std::stable_sort(rows.begin(), rows.end(),
+                [](auto* a, auto* b) { return a->current > b->current; });
         }
-        else {
-            sql += "ORDER BY i.end_time ASC";
+
+        int rendered = 0;
+        for (const auto* it : rows) {
+            renderRow(it->id, it->title, it->sellerEmail, it->sellerId,
+                it->current, it->endEpoch, currentUserId);
+            if (++rendered % kFlushEvery == 0) {
+                std::cout.flush();
+            }
         }
+    }
+    else if (conn) {
+        std::pmr::string sql(arena());
+        appendListingSql(sql, hasSearch, sortKey);
+
+        // Bind request time (+ search parameters if needed)
+        MYSQL_BIND params[3];
+        std::memset(params, 0, sizeof(params));
+        long long nowEpoch = static_cast<long long>(requestTime_);
+        params[0].buffer_type = MYSQL_TYPE_LONGLONG;
+        params[0].buffer = &nowEpoch;
+
+        std::pmr::string likePattern(arena());
+        if (hasSearch) {
+            likePattern += '%';
+            likePattern += searchTerm;
+            likePattern += '%';
 
-        MYSQL_STMT* stmt = mysql_stmt_init(conn);
-        if (stmt && mysql_stmt_prepare(stmt, sql.c_str(), sql.size()) == 0) {
+            params[1].buffer_type = MYSQL_TYPE_STRING;
+            params[1].buffer = (char*)likePattern.c_str();
+            params[1].buffer_length = likePattern.size();
 
-            // Bind search parameters if needed
-            MYSQL_BIND params[2];
-            std::memset(params, 0, sizeof(params));
-            std::string likePattern;
-            if (hasSearch) {
-                likePattern = "%" + searchTerm + "%";
+            params[2].buffer_type = MYSQL_TYPE_STRING;
+            params[2].buffer = (char*)likePattern.c_str();
+            params[2].buffer_length = likePattern.size();
+        }
 
-                params[0].buffer_type = MYSQL_TYPE_STRING;
-                params[0].buffer = (char*)likePattern.c_str();
-                params[0].buffer_length = likePattern.size();
+        // Bind result columns
+        int itemId = 0;
+        long sellerId = 0;
 
-                params[1].buffer_type = MYSQL_TYPE_STRING;
-                params[1].buffer = (char*)likePattern.c_str();
-                params[1].buffer_length = likePattern.size();
+        char titleBuf[101];
+        unsigned long titleLen = 0;
 
-                mysql_stmt_bind_param(stmt, params);
-            }
+        char emailBuf[129];
+        unsigned long emailLen = 0;
+
+        long long currentBidCents = 0;
+        long long endEpoch = 0;
+
+        MYSQL_BIND result[6];
+        std::memset(result, 0, sizeof(result));
+
+        result[0].buffer_type = MYSQL_TYPE_LONG;
+        result[0].buffer = &itemId;
+        result[0].is_unsigned = 1;
+
+        result[1].buffer_type = MYSQL_TYPE_STRING;
+        result[1].buffer = titleBuf;
+        result[1].buffer_length = sizeof(titleBuf);
+        result[1].length = &titleLen;
 
-            if (mysql_stmt_execute(stmt) == 0) {
-                // Bind result columns
-                int itemId = 0;
-                long sellerId = 0;
-
-                char titleBuf[101];
-                unsigned long titleLen = 0;
-
-                char emailBuf[129];
-                unsigned long emailLen = 0;
-
-                double currentBid = 0.0;
-                MYSQL_TIME endTime;
-
-                MYSQL_BIND result[6];
-                std::memset(result, 0, sizeof(result));
-
-                result[0].buffer_type = MYSQL_TYPE_LONG;
-                result[0].buffer = &itemId;
-                result[0].is_unsigned = 1;
-
-                result[1].buffer_type = MYSQL_TYPE_STRING;
-                result[1].buffer = titleBuf;
-                result[1].buffer_length = sizeof(titleBuf);
-                result[1].length = &titleLen;
-
-                result[2].buffer_type = MYSQL_TYPE_STRING;
-                result[2].buffer = emailBuf;
-                result[2].buffer_length = sizeof(emailBuf);
-                result[2].length = &emailLen;
-
-                result[3].buffer_type = MYSQL_TYPE_LONG;
-                result[3].buffer = &sellerId;
-                result[3].is_unsigned = 1;
-
-                result[4].buffer_type = MYSQL_TYPE_DOUBLE;
-                result[4].buffer = &currentBid;
-
-                result[5].buffer_type = MYSQL_TYPE_DATETIME;
-                result[5].buffer = &endTime;
-
-                if (mysql_stmt_bind_result(stmt, result) == 0) {
-                    mysql_stmt_store_result(stmt);
-
-                    int fetchStatus = mysql_stmt_fetch(stmt);
-                    while (fetchStatus == 0 || fetchStatus == MYSQL_DATA_TRUNCATED) {
-                        std::string title(titleBuf, titleLen);
-                        std::string sellerEmail(emailBuf, emailLen);
-
-                        std::string timeLeft = formatTimeLeft(endTime);
-                        std::string bidText = formatCurrency(currentBid);
-
-                        bool canBid =
-                            isLoggedIn &&
-                            currentUserId > 0 &&
-                            currentUserId != sellerId;
-
-                        std::cout << "          <tr>\n";
-
-                        // Item: link to bid page for that item
-                        std::cout << "            <td>";
-                        std::cout << "<a href='bid.cgi?item_id="
-                            << itemId
-                            << "'>"
-                            << htmlEscape(title)
-                            << "</a>";
-                        std::cout << "</td>\n";
-
-                        // Seller
-                        std::cout << "            <td>"
-                            << htmlEscape(sellerEmail)
-                            << "</td>\n";
-
-                        // Current bid (+ optional Bid button)
-                        std::cout << "            <td>"
-                            << htmlEscape(bidText);
-                        if (canBid) {
-                            std::cout << "  ";
-                            std::cout << "<a class='btn primary' "
-                                "style='margin-left:6px; display:inline-block;"
-                                "vertical-align:middle;' "
-                                "href='bid.cgi?item_id="
-                                << itemId
-                                << "'>Bid</a>";
-                        }
-
-                        std::cout << "</td>\n";
-
-                        // Time left
-                        std::cout << "            <td>"
-                            << htmlEscape(timeLeft)
-                            << "</td>\n";
-
-                        std::cout << "          </tr>\n";
-
-                        fetchStatus = mysql_stmt_fetch(stmt);
-                    }
+        result[2].buffer_type = MYSQL_TYPE_STRING;
+        result[2].buffer = emailBuf;
+        result[2].buffer_length = sizeof(emailBuf);
+        result[2].length = &emailLen;
+
+        result[3].buffer_type = MYSQL_TYPE_LONG;
+        result[3].buffer = &sellerId;
+        result[3].is_unsigned = 1;
+
+        result[4].buffer_type = MYSQL_TYPE_LONGLONG;
+        result[4].buffer = &currentBidCents;
+
+        result[5].buffer_type = MYSQL_TYPE_LONGLONG;
+        result[5].buffer = &endEpoch;
+
+        // Page chrome goes out before the query runs
+        std::cout.flush();
+
+        // Rows stream straight off the wire (no store_result), and
+        // the response is flushed every kFlushEvery rows, so first
+        // byte and peak memory do not grow with the listing size.
+        Statement stmt(db_, sql, Database::Route::Replica);
+        if (stmt.bindParams(params) &&
+            stmt.execute(Statement::Fetch::Streaming) &&
+            stmt.bindResult(result)) {
+            int rendered = 0;
+            while (stmt.fetch()) {
+                std::string_view title(titleBuf, titleLen < sizeof(titleBuf) ? titleLen : sizeof(titleBuf));
+                std::string_view sellerEmail(emailBuf, emailLen < sizeof(emailBuf) ? emailLen : sizeof(emailBuf));
+
+                renderRow(itemId, title, sellerEmail, sellerId,
+                    Money::fromCents(currentBidCents), endEpoch, currentUserId);
+
+                if (++rendered % kFlushEvery == 0) {
+                    std::cout.flush();
                 }
             }
-
-            mysql_stmt_close(stmt);
-        }
-        else if (stmt) {
-            mysql_stmt_close(stmt);
+            if (stmt.failed()) {
+                std::cout
+                    << "          <tr>\n"
+                    << "            <td colspan=\"4\" class=\"error\">"
+                    << "Some auctions could not be loaded. Please refresh."
+                    << "</td>\n"
+                    << "          </tr>\n";
+            }
         }
     }
     else {
@@ -460,6 +455,8 @@ void BrowsePage::handleGet() {
         << "  updateEmptyState();\n"
         << "})();\n"
         << "</script>\n";
+    printCountdownScript();
+    printLiveScript();
 
     printTail();
 }
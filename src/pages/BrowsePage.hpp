@@ -3,23 +3,40 @@
 #define TEA_PAGES_BROWSE_PAGE_HPP
 
 #include "core/Page.hpp"
+#include "utils/Money.hpp"
+#include <memory_resource>
+#include <string>
+#include <string_view>
 
 // -----------------------------------------------------------------------------
 // BrowsePage
-// Visual-only templated page for listing auctions. No DB wiring here.
-// Back-end can populate items via handleGet() once connected to DB.
+// Lists unexpired auctions, with optional title search and sort.
+// Unsearched listings come from the shared ActiveItemsCache
+// snapshot; searches (or no snapshot) query a replica directly.
 // -----------------------------------------------------------------------------
 class BrowsePage : public Page {
 public:
-    explicit BrowsePage(Database& db, Session& session);
+    explicit BrowsePage(RequestContext& ctx);
 
-    // GET: render the browse UI with pagination controls.
-    // Note: This is a static template right now; see BrowsePage.cpp
-    // for the "INSERT BACKEND HERE" markers where items should be injected.
+    // Write one listing <tr> to std::cout (no DB access; also used
+    // by the benchmarks with canned rows).
+    static void renderRow(long itemId,
+        std::string_view title,
+        std::string_view sellerEmail,
+        long sellerId,
+        Money currentBid,
+        long long endEpoch,
+        long currentUserId);
+
+    // Append the direct-path listing query for a search / sort
+    // combination (also run under EXPLAIN by make plan-test).
+    static void appendListingSql(std::pmr::string& sql, bool hasSearch, std::string_view sortKey);
+
+    // GET: render the listing for ?q= / ?sort=
     void handleGet() override;
 
-    // No POST handling for now.
-    void handlePost() override {}  // keep to satisfy virtual in base if desired
+    // Browsing is read-only; POST renders nothing
+    void handlePost() override {}
 };
 
 #endif // TEA_PAGES_BROWSE_PAGE_HPP
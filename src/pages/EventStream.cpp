@@ -0,0 +1,165 @@
+// pages/EventStream.cpp
+#include "pages/EventStream.hpp"
+#include "core/BidEvents.hpp"
+#include "core/ConcurrencyLimiter.hpp"
+#include "utils/FormData.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+constexpr std::size_t kMaxItems = 500;
+constexpr auto kHeartbeat = std::chrono::seconds(15);
+constexpr auto kStuckSlot = std::chrono::seconds(2);
+
+unsigned envUnsigned(const char* name, unsigned fallback) {
+    const char* v = std::getenv(name);
+    if (!v || !*v) return fallback;
+    unsigned out = 0;
+    const char* end = v + std::strlen(v);
+    auto [ptr, ec] = std::from_chars(v, end, out);
+    return (ec == std::errc() && ptr == end) ? out : fallback;
+}
+
+std::uint64_t parseU64(const char* v) {
+    std::uint64_t out = 0;
+    if (!v) return 0;
+    const char* end = v + std::strlen(v);
+    auto [ptr, ec] = std::from_chars(v, end, out);
+    return (ec == std::errc() && ptr == end) ? out : 0;
+}
+
+} // namespace
+
+EventStream::EventStream(long viewerId)
+    : viewerId_(viewerId) {
+    if (const char* qs = std::getenv("QUERY_STRING")) {
+        FormData query;
+        query.parse(qs);
+        parseItems(query["items"]);
+    }
+}
+
+// -------------------------------------------------------------
+// "1,2,3" → sorted id list (capped; an oversized list means all)
+// -------------------------------------------------------------
+void EventStream::parseItems(std::string_view list) {
+    while (!list.empty()) {
+        std::size_t comma = list.find(',');
+        std::string_view tok = list.substr(0, comma);
+        long id = 0;
+        auto [ptr, ec] = std::from_chars(tok.data(), tok.data() + tok.size(), id);
+        if (ec == std::errc() && ptr == tok.data() + tok.size() && id > 0)
+            items_.push_back(id);
+        if (items_.size() > kMaxItems) {
+            items_.clear();
+            return;
+        }
+        if (comma == std::string_view::npos) break;
+        list.remove_prefix(comma + 1);
+    }
+    std::sort(items_.begin(), items_.end());
+}
+
+bool EventStream::wants(long itemId) const {
+    return items_.empty() || std::binary_search(items_.begin(), items_.end(), itemId);
+}
+
+// -------------------------------------------------------------
+// Tail the ring until the client leaves or the stream times out
+// -------------------------------------------------------------
+int EventStream::run() {
+    std::cout << "Content-Type: text/event-stream\r\n"
+              << "Cache-Control: no-store\r\n"
+              << "X-Accel-Buffering: no\r\n\r\n";
+
+    // Every open stream pins a web server worker: cap them, and
+    // tell surplus clients to come back later instead of queueing.
+    ConcurrencyLimiter slot("events", envUnsigned("AUCTION_EVENTS_SLOTS", 64));
+    if (!slot.acquire(0)) {
+        std::cout << "retry: 30000\n\n";
+        std::cout.flush();
+        return 0;
+    }
+
+    const auto pollEvery = std::chrono::milliseconds(envUnsigned("AUCTION_EVENTS_POLL_MS", 250));
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::seconds(envUnsigned("AUCTION_EVENTS_MAX_S", 300));
+
+    // Resume after Last-Event-ID while the ring still holds it
+    std::uint64_t head = BidEvents::head();
+    std::uint64_t next = head + 1;
+    if (std::uint64_t last = parseU64(std::getenv("HTTP_LAST_EVENT_ID"))) {
+        if (last <= head && head - last < BidEvents::kSlots)
+            next = last + 1;
+    }
+
+    std::cout << "retry: 3000\n\n";
+    std::cout.flush();
+
+    auto lastWrite = std::chrono::steady_clock::now();
+    auto waitingSince = lastWrite;
+    bool waiting = false;
+
+    while (std::cout && std::chrono::steady_clock::now() < deadline) {
+        BidEvents::Event ev{};
+        switch (BidEvents::read(next, ev)) {
+        case BidEvents::Read::Ok:
+            waiting = false;
+            ++next;
+            if (!wants(ev.itemId)) continue;
+            std::cout << "id: " << ev.seq << "\n"
+                      << "event: bid\n"
+                      << "data: {\"item\":" << ev.itemId
+                      << ",\"price\":\"" << ev.price << "\""
+                      << ",\"end\":" << static_cast<long long>(ev.endEpoch)
+                      << ",\"you\":" << (viewerId_ > 0 && ev.leaderId == viewerId_ ? "true" : "false")
+                      << "}\n\n";
+            std::cout.flush();
+            lastWrite = std::chrono::steady_clock::now();
+            continue;
+
+        case BidEvents::Read::Lost:
+            // Fell a full lap behind: the page must reload its state.
+            // Then poll as usual rather than re-reading at once.
+            std::cout << "event: resync\ndata: {}\n\n";
+            std::cout.flush();
+            lastWrite = std::chrono::steady_clock::now();
+            waiting = false;
+            next = BidEvents::head() + 1;
+            std::this_thread::sleep_for(pollEvery);
+            continue;
+
+        case BidEvents::Read::Unavailable:
+            // No ring to tail: end the stream and keep the client
+            // away for a while, as for a full house
+            std::cout << "retry: 30000\n\n";
+            std::cout.flush();
+            return 0;
+
+        case BidEvents::Read::NotYet:
+            break;
+        }
+
+        // A publisher that died between claiming and stamping its
+        // slot must not stall the stream forever
+        const auto now = std::chrono::steady_clock::now();
+        if (next <= BidEvents::head()) {
+            if (!waiting) { waiting = true; waitingSince = now; }
+            else if (now - waitingSince > kStuckSlot) { ++next; waiting = false; continue; }
+        }
+
+        if (now - lastWrite >= kHeartbeat) {
+            std::cout << ": ping\n\n";
+            std::cout.flush();
+            lastWrite = now;
+        }
+        std::this_thread::sleep_for(pollEvery);
+    }
+    return 0;
+}
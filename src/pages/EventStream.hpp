@@ -0,0 +1,29 @@
+// pages/EventStream.hpp
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// ------------------------------------------------------------------
+// EventStream (events.cgi)
+// - text/event-stream of accepted bids for the items a page shows
+//   (?items=1,2,3; no list = every item), tailed from BidEvents
+// - Each event: id = ring seq, event "bid", data
+//   {"item":N,"price":"12.34","end":EPOCH,"you":true|false}
+// - Holds no database connection while streaming; the viewer is
+//   resolved once up front by main_events.cpp
+// ------------------------------------------------------------------
+class EventStream {
+public:
+    explicit EventStream(long viewerId);
+
+    int run();
+
+private:
+    long viewerId_;
+    std::vector<long> items_;   // sorted; empty = all
+
+    void parseItems(std::string_view list);
+    bool wants(long itemId) const;
+};
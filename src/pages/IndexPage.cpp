@@ -3,18 +3,18 @@
 #include "utils/utils.hpp"
 #include <iostream>
 
-IndexPage::IndexPage(Database& db, Session& session)
-    : Page(db, session) {
+IndexPage::IndexPage(RequestContext& ctx)
+    : Page(ctx) {
 }
 
 void IndexPage::handleGet() {
-    std::cout << "Content-type: text/html\n\n";
+    sendHTMLHeader();
 
     std::string userEmail;
-    bool isLoggedIn = session_.validate();
+    bool isLoggedIn = ctx_.loggedIn();
 
     if (isLoggedIn) {
-        userEmail = session_.userEmail();
+        userEmail = ctx_.userEmail();
     }
 
     // ---------------------------------------------------------
@@ -25,7 +25,6 @@ void IndexPage::handleGet() {
 <head>
   <meta charset="utf-8">
   <meta name="viewport" content="width=device-width, initial-scale=1">
-  <meta http-equiv="refresh" content="305">
   <title>Team Elevate — Auctions</title>
   <style>
     :root {
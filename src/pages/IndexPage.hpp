@@ -13,7 +13,7 @@
 // -------------------------------------------------------------
 class IndexPage : public Page {
 public:
-    IndexPage(Database& db, Session& session);
+    IndexPage(RequestContext& ctx);
 
 protected:
     void handleGet() override;
@@ -1,13 +1,21 @@
 #include "pages/LoginPage.hpp"
+#include "core/ConcurrencyLimiter.hpp"
+#include "core/RateSketch.hpp"
+#include "core/Statement.hpp"
+#include "utils/PasswordHash.hpp"
 #include "utils/utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
 #include <cstring>
 
 // -------------------------------------------------------------
 // Constructor
 // -------------------------------------------------------------
-LoginPage::LoginPage(Database& db, Session& session)
-    : Page(db, session) {
+LoginPage::LoginPage(RequestContext& ctx)
+    : Page(ctx) {
 }
 
 // -------------------------------------------------------------
@@ -38,12 +46,56 @@ void LoginPage::handleGet() {
     printTail("auth");
 }
 
+// -------------------------------------------------------------
+// Brute-force guard: shared count-min sketch, no DB or hashing
+// -------------------------------------------------------------
+static unsigned envLimit(const char* name, unsigned fallback) {
+    const char* v = std::getenv(name);
+    if (!v || !*v) return fallback;
+    unsigned out = 0;
+    const char* end = v + std::strlen(v);
+    auto [ptr, ec] = std::from_chars(v, end, out);
+    return (ec == std::errc() && ptr == end && out > 0) ? out : fallback;
+}
+
+bool LoginPage::admitAttempt(const std::string& email) {
+    static const unsigned kWindow   = envLimit("AUCTION_LOGIN_WINDOW_S", 600);
+    static const unsigned kPerEmail = envLimit("AUCTION_LOGIN_MAX_PER_EMAIL", 10);
+    static const unsigned kPerIp    = envLimit("AUCTION_LOGIN_MAX_PER_IP", 50);
+
+    RateSketch sketch("login-sketch-v1", kWindow);
+
+    std::string emailKey = "email:";
+    for (char c : email)
+        emailKey += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+    const char* remoteAddr = std::getenv("REMOTE_ADDR");
+    std::string ipKey = "ip:";
+    ipKey += remoteAddr ? remoteAddr : "unknown";
+
+    // Refused attempts are not counted, so a blocked key
+    // recovers on schedule instead of extending its own ban.
+    if (sketch.estimate(emailKey, requestTime_) >= kPerEmail ||
+        sketch.estimate(ipKey, requestTime_) >= kPerIp) {
+        sendRetryLater("429 Too Many Requests", sketch.secondsUntilDecay(requestTime_),
+            "Too many sign-in attempts. Please wait a few minutes and try again.", "auth");
+        return false;
+    }
+
+    sketch.hit(emailKey, requestTime_);
+    sketch.hit(ipKey, requestTime_);
+    return true;
+}
+
+const char* const LoginPage::kUserByEmailSql =
+    "SELECT user_id, password_hash FROM users WHERE user_email=? LIMIT 1";
+
 // -------------------------------------------------------------
 // POST — Handle login submission
 // -------------------------------------------------------------
 void LoginPage::handlePost() {
-    std::string email = postData_["email"];
-    std::string password = postData_["password"];
+    std::string email(postData_["email"]);
+    std::string password(postData_["password"]);
 
     // Minimal helper to re-render the same form with an error message
     auto showFormWithError = [&](const std::string& msg) {
@@ -79,54 +131,95 @@ void LoginPage::handlePost() {
         return;
     }
 
-    MYSQL* conn = db_.connection();
-    if (!conn) {
-        showFormWithError("Database connection failed. Please try again later.");
+    if (!admitAttempt(email))
         return;
-    }
 
-    std::string hashedPassword = hashPassword(password);
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    const char* sql = "SELECT user_id FROM users WHERE user_email=? AND password_hash=? LIMIT 1";
+    // Stored hash is compared in C++ (salted KDF), not in the WHERE clause
+    const char* sql = kUserByEmailSql;
 
-    if (!stmt || mysql_stmt_prepare(stmt, sql, std::strlen(sql)) != 0) {
-        if (stmt) mysql_stmt_close(stmt);
-        showFormWithError("Internal server error.");
-        return;
-    }
+    MYSQL_BIND param{};
+    memset(&param, 0, sizeof(param));
+    param.buffer_type   = MYSQL_TYPE_STRING;
+    param.buffer        = (char*)email.c_str();
+    param.buffer_length = email.size();
 
-    MYSQL_BIND params[2];
-    memset(params, 0, sizeof(params));
-    params[0].buffer_type   = MYSQL_TYPE_STRING;
-    params[0].buffer        = (char*)email.c_str();
-    params[0].buffer_length = email.size();
-    params[1].buffer_type   = MYSQL_TYPE_STRING;
-    params[1].buffer        = (char*)hashedPassword.c_str();
-    params[1].buffer_length = hashedPassword.size();
-
-    if (mysql_stmt_bind_param(stmt, params) != 0 || mysql_stmt_execute(stmt) != 0) {
-        mysql_stmt_close(stmt);
-        showFormWithError("Internal server error.");
+    long long userId = 0;
+    char storedBuf[256];
+    unsigned long storedLen = 0;
+
+    MYSQL_BIND result[2];
+    memset(result, 0, sizeof(result));
+    result[0].buffer_type   = MYSQL_TYPE_LONGLONG;
+    result[0].buffer        = &userId;
+    result[0].is_unsigned   = 1;
+    result[1].buffer_type   = MYSQL_TYPE_STRING;
+    result[1].buffer        = storedBuf;
+    result[1].buffer_length = sizeof(storedBuf);
+    result[1].length        = &storedLen;
+
+    bool found = false;
+    {
+        Statement stmt(db_, sql);
+        if (!stmt.ok()) {
+            showFormWithError(db_.connection() ? "Internal server error."
+                                               : "Database connection failed. Please try again later.");
+            return;
+        }
+        if (!stmt.bindParams(&param) || !stmt.execute()) {
+            showFormWithError("Internal server error.");
+            return;
+        }
+        found = stmt.bindResult(result) && stmt.fetch();
+    }
+    std::string storedHash(storedBuf, found ? std::min<unsigned long>(storedLen, sizeof(storedBuf)) : 0);
+
+    // Hashing is the expensive step; bound how many run at once
+    // host-wide so a login burst cannot starve browse and bid.
+    ConcurrencyLimiter hashSlots("hash", ConcurrencyLimiter::slotsFromEnv("AUCTION_HASH_SLOTS"));
+    if (!hashSlots.acquire(ConcurrencyLimiter::timeoutFromEnv("AUCTION_HASH_QUEUE_MS", 1500))) {
+        sendRetryLater("503 Service Unavailable", 2,
+            "We are handling a lot of sign-ins right now. Please try again in a moment.", "auth");
         return;
     }
 
-    MYSQL_BIND result{};
-    long long userId = 0;
-    result.buffer_type = MYSQL_TYPE_LONGLONG;
-    result.buffer      = &userId;
-    result.is_unsigned = 1;
-    mysql_stmt_bind_result(stmt, &result);
-    mysql_stmt_store_result(stmt);
+    const unsigned iterations = passwordHashIterations();
+    PasswordCheck check = PasswordCheck::Mismatch;
+    if (found) {
+        check = verifyPassword(password, storedHash, iterations);
+    } else {
+        // Same work for unknown accounts so timing does not reveal them
+        hashPassword(password, iterations);
+    }
 
-    int fetchStatus = mysql_stmt_fetch(stmt);
-    mysql_stmt_close(stmt);
+    // Transparent upgrade of legacy SHA-256 / lower-cost hashes
+    std::string upgraded;
+    if (check == PasswordCheck::MatchNeedsRehash)
+        upgraded = hashPassword(password, iterations);
+    hashSlots.release();
 
-    if (fetchStatus != 0) {
+    if (check == PasswordCheck::Mismatch) {
         // Wrong email/password -> show the same page + error, keep email filled
         showFormWithError("Invalid email or password.");
         return;
     }
 
+    if (!upgraded.empty()) {
+        const char* rehashSql =
+            "UPDATE users SET password_hash=? WHERE user_id=? AND password_hash=?";
+        MYSQL_BIND rp[3];
+        memset(rp, 0, sizeof(rp));
+        rp[0].buffer_type   = MYSQL_TYPE_STRING;
+        rp[0].buffer        = (char*)upgraded.c_str();
+        rp[0].buffer_length = upgraded.size();
+        rp[1].buffer_type   = MYSQL_TYPE_LONGLONG;
+        rp[1].buffer        = &userId;
+        rp[1].is_unsigned   = 1;
+        rp[2].buffer_type   = MYSQL_TYPE_STRING;
+        rp[2].buffer        = (char*)storedHash.c_str();
+        rp[2].buffer_length = storedHash.size();
+        db_.execute(rehashSql, rp, 3);
+    }
+
     // Create session entry in DB
     std::string sessionToken = generateSessionToken();
     const char* remoteAddr = std::getenv("REMOTE_ADDR");
@@ -135,6 +228,7 @@ void LoginPage::handlePost() {
 
     // Cookie header must come before any HTML
     std::cout << "Content-Type: text/html\r\n";
+    sendPositionCookie();
     std::cout << "Set-Cookie: session_token=" << sessionToken
               << "; Path=/; HttpOnly; SameSite=Lax\r\n\r\n";
 
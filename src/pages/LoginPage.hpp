@@ -16,7 +16,10 @@
 class LoginPage : public Page {
 public:
     // Constructor
-    LoginPage(Database& db, Session& session);
+    LoginPage(RequestContext& ctx);
+
+    // Account lookup by email (checked by make plan-test)
+    static const char* const kUserByEmailSql;
 
 protected:
     // Called for GET requests
@@ -24,4 +27,10 @@ protected:
 
     // Called for POST requests
     void handlePost() override;
+
+private:
+    // Sliding-window attempt limits per email and per client IP,
+    // checked before any hashing or database work. Sends the 429
+    // itself and returns false when the attempt is refused.
+    bool admitAttempt(const std::string& email);
 };
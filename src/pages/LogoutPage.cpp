@@ -2,42 +2,17 @@
 #include "pages/LogoutPage.hpp"
 #include "utils/utils.hpp"
 #include <iostream>
-#include <cstdlib>
-#include <cstring>
 
-LogoutPage::LogoutPage(Database& db, Session& session)
-    : Page(db, session) {
+LogoutPage::LogoutPage(RequestContext& ctx)
+    : Page(ctx) {
 }
 
 // -------------------------------------------------------------
 // GET — perform logout and show confirmation
 // -------------------------------------------------------------
 void LogoutPage::handleGet() {
-    // Retrieve session token from cookies
-    const char* cookieEnv = std::getenv("HTTP_COOKIE");
-    std::string sessionToken;
-    if (cookieEnv) {
-        sessionToken = getCookieValue(std::string(cookieEnv), "session_token");
-    }
-
-    // Delete session from database if token exists
-    if (!sessionToken.empty()) {
-        MYSQL* conn = db_.connection();
-        if (conn) {
-            const char* sql = "DELETE FROM sessions WHERE session_token=?";
-            MYSQL_STMT* stmt = mysql_stmt_init(conn);
-            if (stmt && mysql_stmt_prepare(stmt, sql, std::strlen(sql)) == 0) {
-                MYSQL_BIND param{};
-                memset(&param, 0, sizeof(param));
-                param.buffer_type = MYSQL_TYPE_STRING;
-                param.buffer = (char*)sessionToken.c_str();
-                param.buffer_length = sessionToken.size();
-                mysql_stmt_bind_param(stmt, &param);
-                mysql_stmt_execute(stmt);
-                mysql_stmt_close(stmt);
-            }
-        }
-    }
+    // Delete the session row; also marks this request logged out
+    session_.destroy();
 
     // Clear the cookie
     std::cout << "Content-Type: text/html\r\n";
@@ -46,16 +21,13 @@ void LogoutPage::handleGet() {
     std::cout << "Pragma: no-cache\r\n";
     std::cout << "\r\n"; // end headers
 
-    // Ensure the nav renders as logged-out for THIS response
-    setenv("HTTP_COOKIE", "", 1);
-
     // Output HTML
     printHead("Logged Out · Team Elevate", "auth");
     std::cout
         << "    <section class='card' role='status' aria-live='polite'>\n"
         << "      <h1>✓ Signed out</h1>\n"
         << "      <p class='muted'>Your session has ended. We’re taking you back to the homepage…</p>\n"
-        << "      <script>setTimeout(() => window.location.href='index.cgi', 2000);</script>\n";
+        << "      <script>setTimeout(() => window.location.href='index.cgi', 2000);</script>\n"
         << "      <a class='btn primary' href='index.cgi'>Go to Home</a>\n"
         << "    </section>\n";
     printTail("auth");
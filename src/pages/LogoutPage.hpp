@@ -12,7 +12,7 @@
 // -------------------------------------------------------------
 class LogoutPage : public Page {
 public:
-    LogoutPage(Database& db, Session& session);
+    LogoutPage(RequestContext& ctx);
 
 protected:
     void handleGet() override;   // logout is always GET-driven
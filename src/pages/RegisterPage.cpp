@@ -1,11 +1,14 @@
 ﻿// pages/RegisterPage.cpp
 #include "pages/RegisterPage.hpp"
+#include "core/ConcurrencyLimiter.hpp"
+#include "core/Statement.hpp"
+#include "utils/PasswordHash.hpp"
 #include "utils/utils.hpp"
 #include <iostream>
 #include <cstring>
 
-RegisterPage::RegisterPage(Database& db, Session& session)
-    : Page(db, session) {
+RegisterPage::RegisterPage(RequestContext& ctx)
+    : Page(ctx) {
 }
 
 // -------------------------------------------------------------
@@ -45,9 +48,9 @@ void RegisterPage::handleGet() {
 // POST — Handle registration submission
 // -------------------------------------------------------------
 void RegisterPage::handlePost() {
-    std::string email = postData_["email"];
-    std::string password = postData_["password"];
-    std::string confirm = postData_["confirm"];
+    std::string email(postData_["email"]);
+    std::string password(postData_["password"]);
+    std::string confirm(postData_["confirm"]);
 
     // Validate basic inputs
     if (email.empty() || password.empty() || confirm.empty()) {
@@ -79,26 +82,15 @@ void RegisterPage::handlePost() {
         return;
     }
 
-    MYSQL* conn = db_.connection();
-    if (!conn) {
+    auto showError = [&](const char* msg) {
         sendHTMLHeader();
         printHead("Register · Team Elevate", "auth");
-        std::cout << "<div class='error'>Internal server error. Please try again later.</div>\n";
+        std::cout << "<div class='error'>" << msg << "</div>\n";
         printTail("auth");
-        return;
-    }
+    };
 
     // Check if user already exists
     const char* checkSql = "SELECT user_id FROM users WHERE user_email=? LIMIT 1";
-    MYSQL_STMT* checkStmt = mysql_stmt_init(conn);
-    if (!checkStmt || mysql_stmt_prepare(checkStmt, checkSql, std::strlen(checkSql)) != 0) {
-        if (checkStmt) mysql_stmt_close(checkStmt);
-        sendHTMLHeader();
-        printHead("Register · Team Elevate", "auth");
-        std::cout << "<div class='error'>Internal server error.</div>\n";
-        printTail("auth");
-        return;
-    }
 
     MYSQL_BIND checkParam{};
     memset(&checkParam, 0, sizeof(checkParam));
@@ -106,38 +98,45 @@ void RegisterPage::handlePost() {
     checkParam.buffer = (char*)email.c_str();
     checkParam.buffer_length = email.size();
 
-    mysql_stmt_bind_param(checkStmt, &checkParam);
-    mysql_stmt_execute(checkStmt);
     MYSQL_BIND checkResult{};
     my_ulonglong dummyId = 0;
     checkResult.buffer_type = MYSQL_TYPE_LONGLONG;
     checkResult.buffer = &dummyId;
     checkResult.is_unsigned = 1;
-    mysql_stmt_bind_result(checkStmt, &checkResult);
-    mysql_stmt_store_result(checkStmt);
-    bool exists = (mysql_stmt_fetch(checkStmt) == 0);
-    mysql_stmt_close(checkStmt);
+
+    bool exists = false;
+    {
+        Statement checkStmt(db_, checkSql);
+        if (!checkStmt.ok()) {
+            showError(db_.connection() ? "Internal server error."
+                                       : "Internal server error. Please try again later.");
+            return;
+        }
+        exists = checkStmt.bindParams(&checkParam) && checkStmt.execute() &&
+                 checkStmt.bindResult(&checkResult) && checkStmt.fetch();
+    }
 
     if (exists) {
-        sendHTMLHeader();
-        printHead("Register · Team Elevate", "auth");
-        std::cout << "<div class='error'>This email is already registered. Try logging in instead.</div>\n";
-        printTail("auth");
+        showError("This email is already registered. Try logging in instead.");
         return;
     }
 
-    // Insert new user
-    std::string hashedPassword = hashPassword(password);
-    const char* insertSql = "INSERT INTO users (user_email, password_hash, joindate) VALUES (?, ?, NOW())";
-    MYSQL_STMT* insertStmt = mysql_stmt_init(conn);
-    if (!insertStmt || mysql_stmt_prepare(insertStmt, insertSql, std::strlen(insertSql)) != 0) {
-        if (insertStmt) mysql_stmt_close(insertStmt);
-        sendHTMLHeader();
-        printHead("Register · Team Elevate", "auth");
-        std::cout << "<div class='error'>Internal server error.</div>\n";
-        printTail("auth");
+    // Insert new user (hashing shares the login worker slots)
+    std::string hashedPassword;
+    {
+        ConcurrencyLimiter hashSlots("hash", ConcurrencyLimiter::slotsFromEnv("AUCTION_HASH_SLOTS"));
+        if (!hashSlots.acquire(ConcurrencyLimiter::timeoutFromEnv("AUCTION_HASH_QUEUE_MS", 1500))) {
+            sendRetryLater("503 Service Unavailable", 2,
+                "We are handling a lot of sign-ups right now. Please try again in a moment.", "auth");
+            return;
+        }
+        hashedPassword = hashPassword(password);
+    }
+    if (hashedPassword.empty()) {
+        showError("Internal server error.");
         return;
     }
+    const char* insertSql = "INSERT INTO users (user_email, password_hash, joindate) VALUES (?, ?, NOW())";
 
     MYSQL_BIND insertParams[2];
     memset(insertParams, 0, sizeof(insertParams));
@@ -148,19 +147,20 @@ void RegisterPage::handlePost() {
     insertParams[1].buffer = (char*)hashedPassword.c_str();
     insertParams[1].buffer_length = hashedPassword.size();
 
-    mysql_stmt_bind_param(insertStmt, insertParams);
-    if (mysql_stmt_execute(insertStmt) != 0) {
-        mysql_stmt_close(insertStmt);
-        sendHTMLHeader();
-        printHead("Register · Team Elevate", "auth");
-        std::cout << "<div class='error'>Could not create account.</div>\n";
-        printTail("auth");
-        return;
+    unsigned long long newUserId = 0;
+    {
+        Statement insertStmt(db_, insertSql);
+        if (!insertStmt.ok()) {
+            showError("Internal server error.");
+            return;
+        }
+        if (!insertStmt.bindParams(insertParams) || !insertStmt.execute()) {
+            showError("Could not create account.");
+            return;
+        }
+        newUserId = insertStmt.insertId();
     }
 
-    unsigned long long newUserId = mysql_insert_id(conn);
-    mysql_stmt_close(insertStmt);
-
     // Create new session
     std::string sessionToken = generateSessionToken();
     const char* remoteAddr = std::getenv("REMOTE_ADDR");
@@ -171,6 +171,7 @@ void RegisterPage::handlePost() {
     // Correct header order for cookies
     // ---------------------------------------------------------
     std::cout << "Content-Type: text/html\r\n";
+    sendPositionCookie();
     std::cout << "Set-Cookie: session_token=" << sessionToken
         << "; Path=/; HttpOnly; SameSite=Lax\r\n\r\n";
 
@@ -14,7 +14,7 @@
 
 class RegisterPage : public Page {
 public:
-    RegisterPage(Database& db, Session& session);
+    RegisterPage(RequestContext& ctx);
 
 protected:
     void handleGet() override;
@@ -1,19 +1,23 @@
 #include "pages/SellPage.hpp"
+#include "core/ActiveItemsCache.hpp"
+#include "core/Statement.hpp"
+#include "core/WriteAdmission.hpp"
 #include "utils/utils.hpp"
+#include "utils/Money.hpp"
 #include <iostream>
 #include <cstring>
 #include <ctime>
 
-SellPage::SellPage(Database& db, Session& session)
-    : Page(db, session) {
+SellPage::SellPage(RequestContext& ctx)
+    : Page(ctx) {
 }
 
 void SellPage::handleGet() {
     sendHTMLHeader();
     printHead("Sell an Item · Team Elevate Auctions");
 
-    const bool isLoggedIn = session_.validate();
-    const std::string userEmail = isLoggedIn ? session_.userEmail() : "";
+    const bool isLoggedIn = ctx_.loggedIn();
+    const std::string userEmail = isLoggedIn ? ctx_.userEmail() : "";
 
     if (isLoggedIn) {
         std::cout << "  <div class='success' role='status'>"
@@ -92,7 +96,7 @@ void SellPage::handleGet() {
 
 void SellPage::handlePost() {
     // Check if user is logged in
-    if (!session_.validate()) {
+    if (!ctx_.loggedIn()) {
         sendHTMLHeader();
         printHead("Sell an Item · Team Elevate Auctions");
         std::cout << R"(  <div class="error" role="alert">
@@ -103,11 +107,23 @@ void SellPage::handlePost() {
         return;
     }
 
+    static constexpr WriteAdmission::Defaults kSellLimits{
+        { 6, 3 },         // per user: 6 listings/min, bursts of 3
+        { 600, 30 },      // all sellers
+        4,                // concurrent listing writes
+        100 };            // ms to wait for a slot
+    WriteAdmission admission("sell", ctx_.userId(), kSellLimits);
+    if (!admission.admitted()) {
+        sendRetryLater("429 Too Many Requests", admission.retryAfter(),
+            "Too many listings are being created right now. Please try again in a moment.");
+        return;
+    }
+
     // Get form data
-    std::string itemName = postData_["item_name"];
-    std::string description = postData_["description"];
-    std::string startingPriceStr = postData_["starting_price"];
-    std::string startDatetime = postData_["start_datetime"];
+    std::string itemName(postData_["item_name"]);
+    std::string description(postData_["description"]);
+    std::string startingPriceStr(postData_["starting_price"]);
+    std::string startDatetime(postData_["start_datetime"]);
 
     // Helper function to show form with error
     auto showFormWithError = [&](const std::string& errorMsg) {
@@ -115,7 +131,7 @@ void SellPage::handlePost() {
         printHead("Sell an Item · Team Elevate Auctions");
 
         std::cout << "  <div class='success' role='status'>"
-                  << "Logged in as <strong>" << htmlEscape(session_.userEmail()) << "</strong>"
+                  << "Logged in as <strong>" << htmlEscape(ctx_.userEmail()) << "</strong>"
                   << "</div>\n";
 
         std::cout << "  <div class='error' role='alert'>" << htmlEscape(errorMsg) << "</div>\n";
@@ -172,25 +188,15 @@ void SellPage::handlePost() {
     }
 
     // Parse and validate price
-    double startingPrice = 0.0;
-    try {
-        size_t pos = 0;
-        startingPrice = std::stod(startingPriceStr, &pos);
-
-        // Check if the entire string was consumed (valid number)
-        if (pos != startingPriceStr.length()) {
-            showFormWithError("Invalid starting price format.");
-            return;
-        }
-
-        if (startingPrice <= 0) {
-            showFormWithError("Starting price must be greater than zero.");
-            return;
-        }
-    } catch (...) {
+    Money startingPrice;
+    if (!Money::parse(startingPriceStr, startingPrice)) {
         showFormWithError("Invalid starting price format.");
         return;
     }
+    if (startingPrice <= Money()) {
+        showFormWithError("Starting price must be greater than zero.");
+        return;
+    }
 
     if (startDatetime.empty() || startDatetime.length() < 16) {
         showFormWithError("Starting date and time is required.");
@@ -212,66 +218,48 @@ void SellPage::handlePost() {
     }
     startTimeMysql += ":00"; // Add seconds
 
-    // Get database connection
-    MYSQL* conn = db_.connection();
-    if (!conn) {
-        showFormWithError("Database connection failed. Please try again later.");
-        return;
-    }
-
     // Validate that start time is not in the past
-    const char* checkSql = "SELECT ? > NOW() as is_future";
-    MYSQL_STMT* checkStmt = mysql_stmt_init(conn);
-    if (checkStmt && mysql_stmt_prepare(checkStmt, checkSql, std::strlen(checkSql)) == 0) {
-        MYSQL_BIND checkParam{};
-        std::memset(&checkParam, 0, sizeof(checkParam));
-        checkParam.buffer_type = MYSQL_TYPE_STRING;
-        checkParam.buffer = (char*)startTimeMysql.c_str();
-        checkParam.buffer_length = startTimeMysql.size();
-
-        mysql_stmt_bind_param(checkStmt, &checkParam);
-        mysql_stmt_execute(checkStmt);
-
-        MYSQL_BIND checkResult{};
-        int isFuture = 0;
-        checkResult.buffer_type = MYSQL_TYPE_LONG;
-        checkResult.buffer = &isFuture;
-        mysql_stmt_bind_result(checkStmt, &checkResult);
-        mysql_stmt_fetch(checkStmt);
-        mysql_stmt_close(checkStmt);
-
-        if (isFuture == 0) {
-            showFormWithError("Starting date and time must be in the future.");
+    const char* checkSql = "SELECT ? > FROM_UNIXTIME(?) as is_future";
+    long long nowEpoch = static_cast<long long>(requestTime_);
+    MYSQL_BIND checkParam[2];
+    std::memset(checkParam, 0, sizeof(checkParam));
+    checkParam[0].buffer_type = MYSQL_TYPE_STRING;
+    checkParam[0].buffer = (char*)startTimeMysql.c_str();
+    checkParam[0].buffer_length = startTimeMysql.size();
+    checkParam[1].buffer_type = MYSQL_TYPE_LONGLONG;
+    checkParam[1].buffer = &nowEpoch;
+
+    MYSQL_BIND checkResult{};
+    int isFuture = 0;
+    checkResult.buffer_type = MYSQL_TYPE_LONG;
+    checkResult.buffer = &isFuture;
+
+    {
+        Statement checkStmt(db_, checkSql);
+        if (!checkStmt.ok()) {
+            showFormWithError(db_.connection() ? "Failed to validate start time."
+                                               : "Database connection failed. Please try again later.");
             return;
         }
-    } else {
-        if (checkStmt) mysql_stmt_close(checkStmt);
-        showFormWithError("Failed to validate start time.");
+        checkStmt.bindParams(checkParam) && checkStmt.execute() &&
+            checkStmt.bindResult(&checkResult) && checkStmt.fetch();
+    }
+    if (isFuture == 0) {
+        showFormWithError("Starting date and time must be in the future.");
         return;
     }
 
     // Insert the item into the database
     const char* sql =
         "INSERT INTO items (seller_id, title, description, start_price, start_time, end_time) "
-        "VALUES (?, ?, ?, ?, ?, DATE_ADD(?, INTERVAL 7 DAY))";
-
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (!stmt) {
-        showFormWithError("Internal server error.");
-        return;
-    }
-
-    if (mysql_stmt_prepare(stmt, sql, std::strlen(sql)) != 0) {
-        mysql_stmt_close(stmt);
-        showFormWithError("Internal server error.");
-        return;
-    }
+        "VALUES (?, ?, ?, ? / 100, ?, DATE_ADD(?, INTERVAL 7 DAY))";
 
     // Bind parameters
     MYSQL_BIND params[6];
     std::memset(params, 0, sizeof(params));
 
-    long sellerId = session_.userId();
+    long sellerId = ctx_.userId();
+    long long startingCents = startingPrice.cents();
 
     // seller_id
     params[0].buffer_type = MYSQL_TYPE_LONG;
@@ -289,8 +277,8 @@ void SellPage::handlePost() {
     params[2].buffer_length = description.size();
 
     // start_price
-    params[3].buffer_type = MYSQL_TYPE_DOUBLE;
-    params[3].buffer = &startingPrice;
+    params[3].buffer_type = MYSQL_TYPE_LONGLONG;
+    params[3].buffer = &startingCents;
 
     // start_time
     params[4].buffer_type = MYSQL_TYPE_STRING;
@@ -302,29 +290,35 @@ void SellPage::handlePost() {
     params[5].buffer = (char*)startTimeMysql.c_str();
     params[5].buffer_length = startTimeMysql.size();
 
-    if (mysql_stmt_bind_param(stmt, params) != 0) {
-        mysql_stmt_close(stmt);
-        showFormWithError("Internal server error.");
-        return;
+    {
+        Statement stmt(db_, sql);
+        if (!stmt.ok() || !stmt.bindParams(params)) {
+            showFormWithError("Internal server error.");
+            return;
+        }
+        if (!stmt.execute()) {
+            showFormWithError(std::string("Failed to list item: ") + stmt.error());
+            return;
+        }
     }
 
-    if (mysql_stmt_execute(stmt) != 0) {
-        std::string error = mysql_stmt_error(stmt);
-        mysql_stmt_close(stmt);
-        showFormWithError("Failed to list item: " + error);
-        return;
-    }
+    // Seller row for My Transactions (LAST_INSERT_ID() is the new item)
+    const char* activitySql =
+        "INSERT INTO user_item_activity (user_id, item_id, role, max_bid, end_time) "
+        "VALUES (?, LAST_INSERT_ID(), 'seller', NULL, DATE_ADD(?, INTERVAL 7 DAY))";
+    MYSQL_BIND activityParams[2];
+    std::memset(activityParams, 0, sizeof(activityParams));
+    activityParams[0] = params[0];   // seller_id
+    activityParams[1] = params[4];   // start_time
+    db_.execute(activitySql, activityParams, 2);
 
-    mysql_stmt_close(stmt);
+    // New listing: the shared active-items snapshot is stale
+    ActiveItemsCache::invalidate();
 
     // Success! Show confirmation page
     sendHTMLHeader();
     printHead("Item Listed Successfully · Team Elevate Auctions");
 
-    // Format price to 2 decimal places
-    char priceBuffer[32];
-    std::snprintf(priceBuffer, sizeof(priceBuffer), "%.2f", startingPrice);
-
     // Format datetime for display (remove T, make it readable)
     std::string displayDatetime = startDatetime;
     size_t tDisplay = displayDatetime.find('T');
@@ -337,7 +331,7 @@ void SellPage::handlePost() {
       <h1>✓ Item Listed Successfully</h1>
       <div class="success">Your item "<strong>)" << htmlEscape(itemName) << R"(</strong>" has been listed for auction.</div>
       <div class="muted" style="margin-top:12px;">
-        <strong>Starting price:</strong> $)" << priceBuffer << R"(<br>
+        <strong>Starting price:</strong> $)" << startingPrice << R"(<br>
         <strong>Auction starts:</strong> )" << htmlEscape(displayDatetime) << R"(<br>
         <strong>Duration:</strong> 7 days
       </div>
@@ -14,9 +14,12 @@
 // -------------------------------------------------------------
 class SellPage : public Page {
 public:
-    SellPage(Database& db, Session& session);
+    SellPage(RequestContext& ctx);
 
 protected:
     void handleGet() override; // render the Sell form (no backend logic here)
 	void handlePost() override; // Process form submission and create a listing
+
+    // Descriptions can be long; allow a larger body than the default.
+    std::size_t maxPostBytes() const override { return 64 * 1024; }
 };
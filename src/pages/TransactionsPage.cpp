@@ -1,73 +1,204 @@
 // pages/TransactionsPage.cpp
 #include "pages/TransactionsPage.hpp"
+#include "core/ActivityQuery.hpp"
 #include "utils/utils.hpp"
+#include "utils/Money.hpp"
 #include <iostream>
-#include <vector>
+#include <string>
+#include <string_view>
 #include <cstring>
-#include <functional>
+#include <cstdlib>
+#include <charconv>
+#include <ctime>
 
-TransactionsPage::TransactionsPage(Database& db, Session& session)
-    : Page(db, session) {
+TransactionsPage::TransactionsPage(RequestContext& ctx)
+    : Page(ctx) {
 }
 
-// Helper to run prepared queries and print rows
-static bool runQueryAndPrint(
-    MYSQL* conn,
-    const std::string& sql,
-    MYSQL_BIND* params,
-    unsigned int paramCount,
-    const std::function<void(MYSQL_BIND*, unsigned long*)>& printRow,
-    unsigned int expectedCols = 0)
-{
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
-    if (!stmt) return false;
-    if (mysql_stmt_prepare(stmt, sql.c_str(), sql.size()) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-    if (paramCount > 0 && mysql_stmt_bind_param(stmt, params) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-    if (mysql_stmt_execute(stmt) != 0) {
-        mysql_stmt_close(stmt);
-        return false;
+// -------------------------------------------------------------
+// Rows shown per section on first paint and per "load more"
+// -------------------------------------------------------------
+static constexpr int kPageSize = 25;
+
+// -------------------------------------------------------------
+// Query layer (shared with the JSON API)
+// -------------------------------------------------------------
+using SectionSpec = ActivityQuery::Section;
+using Cursor = ActivityQuery::Cursor;
+using ParamList = ActivityQuery::Params;
+using ActivityRow = ActivityQuery::Row;
+
+// -------------------------------------------------------------
+// Small append helpers (rows are buffered per section so the
+// "more" cursor is known before anything is printed)
+// -------------------------------------------------------------
+static void appendMoney(std::pmr::string& out, Money m) {
+    char buf[Money::kMaxChars];
+    out += '$';
+    out.append(buf, m.format(buf));
+}
+
+static void appendInt(std::pmr::string& out, long long v) {
+    char buf[24];
+    out.append(buf, std::to_chars(buf, buf + sizeof(buf), v).ptr);
+}
+
+// Fallback text for <time class='dt'>; the page script rewrites
+// it in Pacific Time. UTC keeps the output independent of the
+// server's zone database.
+static void appendTime(std::pmr::string& out, long long epoch) {
+    std::time_t t = static_cast<std::time_t>(epoch);
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    char buf[40];
+    std::size_t n = std::strftime(buf, sizeof(buf), "%m/%d/%Y %I:%M %p UTC", &tm);
+    out += "<time class='dt' data-epoch='";
+    appendInt(out, epoch);
+    out += "'>";
+    out.append(buf, n);
+    out += "</time>";
+}
+
+static void appendLeader(std::pmr::string& out, const ActivityRow& r) {
+    if (r.leader.empty()) out += "—";
+    else appendHtmlEscaped(out, r.leader);
+}
+
+// -------------------------------------------------------------
+// Row renderers, one per tab
+// -------------------------------------------------------------
+static void renderSellingRow(std::pmr::string& out, const ActivityRow& r, std::time_t now) {
+    out += "<tr><td><span class='name-wrap'>";
+    appendHtmlEscaped(out, r.title);
+    out += "</span></td><td>";
+    out += (r.endEpoch <= now) ? "Closed" : "Active";
+    out += "</td><td>";
+    appendTime(out, r.endEpoch);
+    out += "</td><td>";
+    appendLeader(out, r);
+    out += "</td><td>";
+    appendMoney(out, r.topBid);
+    out += "</td></tr>\n";
+}
+
+static void renderClosedRow(std::pmr::string& out, const ActivityRow& r) {
+    out += "<tr><td><span class='name-wrap'>";
+    appendHtmlEscaped(out, r.title);
+    out += "</span></td><td>";
+    appendMoney(out, r.topBid);
+    out += "</td><td>";
+    appendTime(out, r.endEpoch);
+    out += "</td></tr>\n";
+}
+
+static void renderBidRow(std::pmr::string& out, const ActivityRow& r) {
+    out += "<tr>\n  <td title='";
+    appendHtmlEscaped(out, r.title);
+    out += "'><span class='name-wrap'>";
+    appendHtmlEscaped(out, r.title);
+    out += "</span></td>\n  <td>";
+    appendTime(out, r.endEpoch);
+    out += "</td>\n  <td>";
+    appendLeader(out, r);
+    out += "</td>\n  <td>";
+    appendMoney(out, r.topBid);
+    out += "</td>\n  <td>";
+    appendMoney(out, r.myMax);
+    out += "</td>\n"
+           "  <td>\n"
+           "    <div class='action-cell'>\n"
+           "      <form class='inline-form' action='bid.cgi' method='post'>\n"
+           "        <input type='hidden' name='item_id' value='";
+    appendInt(out, r.itemId);
+    out += "'>\n"
+           "        <input name='bid_amount' type='number' step='0.01' placeholder='Enter new max' required>\n"
+           "        <button class='btn primary' type='submit'>Increase</button>\n"
+           "      </form>\n"
+           "    </div>\n"
+           "  </td>\n"
+           "</tr>\n";
+}
+
+void TransactionsPage::renderRow(std::pmr::string& out, const ActivityQuery::Section& s,
+    const ActivityQuery::Row& r, std::time_t now) {
+    if (&s == &ActivityQuery::kSelling)      renderSellingRow(out, r, now);
+    else if (&s == &ActivityQuery::kBids)    renderBidRow(out, r);
+    else                                     renderClosedRow(out, r);
+}
+
+// -------------------------------------------------------------
+// Collected page of rows for one section
+// -------------------------------------------------------------
+struct SectionPage {
+    explicit SectionPage(std::pmr::memory_resource* mr) : rows(mr) {}
+
+    std::pmr::string rows;
+    int count = 0;
+    Cursor last;
+    bool hasMore = false;
+};
+
+static void addRow(SectionPage& page, const SectionSpec& s, const ActivityRow& r, std::time_t now) {
+    // The query fetched one extra row only to learn whether more exist
+    if (page.count == kPageSize) {
+        page.hasMore = true;
+        return;
     }
+    TransactionsPage::renderRow(page.rows, s, r, now);
+    page.last.endEpoch = r.endEpoch;
+    page.last.itemId = r.itemId;
+    ++page.count;
+}
 
-    MYSQL_RES* meta = mysql_stmt_result_metadata(stmt);
-    if (!meta) { mysql_stmt_close(stmt); return false; }
-    unsigned int numCols = mysql_num_fields(meta);
-    if (expectedCols > 0 && numCols != expectedCols) numCols = expectedCols;
-
-    std::vector<std::vector<char>> buffers(numCols, std::vector<char>(256));
-    std::vector<unsigned long> lengths(numCols);
-    std::vector<MYSQL_BIND> result(numCols);
-    memset(result.data(), 0, sizeof(MYSQL_BIND) * numCols);
-    for (unsigned int i = 0; i < numCols; ++i) {
-        result[i].buffer_type = MYSQL_TYPE_STRING;
-        result[i].buffer = buffers[i].data();
-        result[i].buffer_length = buffers[i].size();
-        result[i].length = &lengths[i];
+// -------------------------------------------------------------
+// GET ?section=<id>&after=<cursor> — rows-only fragment
+// -------------------------------------------------------------
+void TransactionsPage::handleFragment(std::string_view sectionId, std::string_view afterText) {
+    const SectionSpec* spec = ActivityQuery::findSection(sectionId);
+    Cursor after;
+    if (!spec || !ActivityQuery::parseCursor(afterText, after) || !db_.connection()) {
+        std::cout << "Status: 400 Bad Request\r\nContent-Type: text/plain\r\n\r\nBad section or cursor.\n";
+        return;
     }
 
-    mysql_stmt_bind_result(stmt, result.data());
-    mysql_stmt_store_result(stmt);
+    std::pmr::string sql(arena());
+    ParamList params;
+    ActivityQuery::appendSection(sql, params, *spec, ctx_.userId(), requestTime_, &after, kPageSize + 1);
 
-    bool any = false;
-    while (mysql_stmt_fetch(stmt) == 0) {
-        any = true;
-        printRow(result.data(), lengths.data());
+    SectionPage page(arena());
+    bool ok = ActivityQuery::scan(db_, sql, params, [&](const ActivityRow& r) {
+        addRow(page, *spec, r, requestTime_);
+    });
+    if (!ok) {
+        std::cout << "Status: 500 Internal Server Error\r\nContent-Type: text/plain\r\n\r\nQuery failed.\n";
+        return;
     }
 
-    mysql_free_result(meta);
-    mysql_stmt_close(stmt);
-    return any;
+    std::cout << "Content-Type: text/html\r\n"
+              << "Cache-Control: no-store\r\n";
+    if (page.hasMore) std::cout << "X-Next-Cursor: " << ActivityQuery::formatCursor(page.last) << "\r\n";
+    std::cout << "\r\n" << page.rows;
 }
 
 void TransactionsPage::handleGet() {
-    // Redirect BEFORE sending any HTML so we don't need a <meta http-equiv="refresh"> in body
-    if (!session_.isLoggedIn()) {
-        std::cout << "Status: 302 Found\r\nLocation: login.cgi\r\n\r\n";
+    const char* qs = std::getenv("QUERY_STRING");
+    FormData query(arena());
+    query.parse(qs ? qs : "");
+    const bool fragment = query.contains("section");
+
+    // Redirect BEFORE sending any HTML so we don't need a <meta http-equiv="refresh"> in body.
+    // Fragment fetches get a bare 401 instead: fetch() would follow
+    // the redirect and the script would append the login page.
+    if (!ctx_.loggedIn()) {
+        if (fragment)
+            std::cout << "Status: 401 Unauthorized\r\nCache-Control: no-store\r\n\r\n";
+        else
+            std::cout << "Status: 302 Found\r\nLocation: login.cgi\r\n\r\n";
+        return;
+    }
+
+    if (fragment) {
+        handleFragment(query["section"], query["after"]);
         return;
     }
 
@@ -81,8 +212,7 @@ void TransactionsPage::handleGet() {
         return;
     }
 
-    long userId = session_.userId();
-    std::string email = session_.userEmail();
+    long userId = ctx_.userId();
 
     // ---------------------------------------------------------------------
     // Page header + tiny tab styles
@@ -159,8 +289,55 @@ void TransactionsPage::handleGet() {
     </section>
 )";
 
+
+    // ---------------------------------------------------------------------
+    // First paint: newest kPageSize rows of every section in one
+    // UNION ALL round trip; the rest is fetched on demand.
+    // ---------------------------------------------------------------------
+    std::cout.flush();   // head + tabs reach the browser before the query
+
+    std::pmr::string sql(arena());
+    ParamList params;
+    for (const SectionSpec* s : ActivityQuery::kSections) {
+        if (!sql.empty()) sql += " UNION ALL ";
+        ActivityQuery::appendSection(sql, params, *s, userId, requestTime_, nullptr, kPageSize + 1);
+    }
+
+    SectionPage pages[4] = { SectionPage(arena()), SectionPage(arena()),
+                             SectionPage(arena()), SectionPage(arena()) };
+    bool loaded = ActivityQuery::scan(db_, sql, params, [&](const ActivityRow& r) {
+        for (int i = 0; i < 4; ++i) {
+            if (r.section == ActivityQuery::kSections[i]->id) {
+                addRow(pages[i], *ActivityQuery::kSections[i], r, requestTime_);
+                break;
+            }
+        }
+    });
+
+    if (!loaded) {
+        std::cout << "<div class='error'>Unable to load your transactions right now.</div>\n";
+    }
+
+    auto printSection = [&](const SectionSpec& s) {
+        int i = 0;
+        while (ActivityQuery::kSections[i] != &s) ++i;
+        const SectionPage& page = pages[i];
+        if (page.count == 0) {
+            std::cout << "<tr><td colspan='" << s.columns << "'>" << s.emptyText << "</td></tr>\n";
+        }
+        else {
+            std::cout << page.rows;
+        }
+        std::cout << "</tbody></table>\n";
+        if (page.hasMore) {
+            std::cout << "<button type='button' class='btn tx-more' style='margin-top:12px;' data-section='"
+                      << s.id << "' data-next='" << ActivityQuery::formatCursor(page.last) << "'>Load more</button>\n";
+        }
+        std::cout << "</section>\n";
+    };
+
     // =====================================================
-    // SELLING 
+    // SELLING
     // =====================================================
     std::cout << R"(
     <section id="tab-selling" class="card tx-section active" aria-labelledby="Selling">
@@ -171,47 +348,9 @@ void TransactionsPage::handleGet() {
             <th>Item</th><th>Status</th><th>Ends</th><th>Current Bidder</th><th>Highest Bid</th>
           </tr>
         </thead>
-        <tbody>
+        <tbody id="rows-selling">
 )";
-    {
-        const char* sql =
-            "SELECT i.title, "
-            "CASE WHEN i.end_time<NOW() THEN 'Closed' ELSE 'Active' END AS status, "
-            "DATE_FORMAT(i.end_time,'%m/%d/%Y %h:%i %p') AS end_str, "
-            "UNIX_TIMESTAMP(i.end_time) AS epoch, "
-            "IFNULL(FORMAT((SELECT MAX(b.bid_amount) FROM bids b WHERE b.item_id=i.item_id),2),'0.00') AS highest_bid, "
-            "IFNULL(u.user_email,'—') AS current_bidder "
-            "FROM items i "
-            "LEFT JOIN users u ON u.user_id = i.winner_id "
-            "WHERE i.seller_id=? "
-            "ORDER BY i.end_time DESC";
-
-        MYSQL_BIND p[1]; memset(p, 0, sizeof(p));
-        p[0].buffer_type = MYSQL_TYPE_LONG;
-        p[0].buffer = &userId;
-        p[0].is_unsigned = 1;
-
-        bool any = runQueryAndPrint(conn, sql, p, 1,
-            [&](MYSQL_BIND* res, unsigned long*) {
-                std::string title(htmlEscape((char*)res[0].buffer));
-                std::string status(htmlEscape((char*)res[1].buffer));
-                std::string endsServer(htmlEscape((char*)res[2].buffer));
-                std::string epoch(htmlEscape((char*)res[3].buffer));
-                std::string highest(htmlEscape((char*)res[4].buffer));
-                std::string bidder(htmlEscape((char*)res[5].buffer));
-
-                std::cout << "<tr>"
-                    << "<td><span class='name-wrap'>" << title << "</span></td>"
-                    << "<td>" << status << "</td>"
-                    << "<td><time class='dt' data-epoch='" << epoch << "'>" << endsServer << "</time></td>"
-                    << "<td>" << bidder << "</td>"
-                    << "<td>$" << highest << "</td>"
-                    << "</tr>\n";
-            }, 6);
-
-        if (!any) std::cout << "<tr><td colspan='5'>No listings.</td></tr>\n";
-    }
-    std::cout << "</tbody></table></section>\n";
+    printSection(ActivityQuery::kSelling);
 
     // =====================================================
     // PURCHASES
@@ -221,34 +360,9 @@ void TransactionsPage::handleGet() {
       <h3 style="margin-top:0">Purchases</h3>
       <table aria-label="Items you purchased">
         <thead><tr><th>Item</th><th>Winning Bid</th><th>Closed</th></tr></thead>
-        <tbody>
+        <tbody id="rows-purchases">
 )";
-    {
-        const char* sql =
-            "SELECT i.title, "
-            "IFNULL(FORMAT((SELECT bid_amount FROM bids WHERE bid_id=i.winning_bid_id),2),'0.00'), "
-            "DATE_FORMAT(i.end_time,'%m/%d/%Y %h:%i %p'), "
-            "UNIX_TIMESTAMP(i.end_time) "
-            "FROM items i "
-            "WHERE i.winner_id=? AND i.end_time < NOW() "
-            "ORDER BY i.end_time DESC";
-
-        MYSQL_BIND p[1]; memset(p, 0, sizeof(p));
-        p[0].buffer_type = MYSQL_TYPE_LONG; p[0].buffer = &userId; p[0].is_unsigned = 1;
-
-        bool any = runQueryAndPrint(conn, sql, p, 1,
-            [&](MYSQL_BIND* res, unsigned long*) {
-                std::string title(htmlEscape((char*)res[0].buffer));
-                std::string bid(htmlEscape((char*)res[1].buffer));
-                std::string closedServer(htmlEscape((char*)res[2].buffer));
-                std::string epoch(htmlEscape((char*)res[3].buffer));
-                std::cout << "<tr><td><span class='name-wrap'>" << title
-                          << "</span></td><td>$" << bid
-                          << "</td><td><time class='dt' data-epoch='" << epoch << "'>" << closedServer << "</time></td></tr>\n";
-            }, 4);
-        if (!any) std::cout << "<tr><td colspan='3'>No purchases yet.</td></tr>\n";
-    }
-    std::cout << "</tbody></table></section>\n";
+    printSection(ActivityQuery::kPurchases);
 
     // =====================================================
     // CURRENT BIDS 
@@ -261,58 +375,9 @@ void TransactionsPage::handleGet() {
         <thead>
           <tr><th>Item</th><th>Ends</th><th>Current Leader</th><th>Highest Bid</th><th>Your Max</th><th>Action</th></tr>
         </thead>
-        <tbody>
+        <tbody id="rows-bids">
 )";
-    {
-        const char* sql =
-            "SELECT i.item_id, i.title, "
-            "DATE_FORMAT(i.end_time,'%m/%d/%Y %h:%i %p') AS end_str, "
-            "UNIX_TIMESTAMP(i.end_time) AS epoch, "
-            "IFNULL(u.user_email,'—') AS current_leader, "
-            "IFNULL(FORMAT((SELECT MAX(b2.bid_amount) FROM bids b2 WHERE b2.item_id=i.item_id),2),'0.00') AS highest_bid, "
-            "IFNULL(FORMAT((SELECT MAX(b1.bid_amount) FROM bids b1 WHERE b1.item_id=i.item_id AND b1.bidder_id=?),2),'0.00') AS your_max "
-            "FROM items i "
-            "LEFT JOIN users u ON u.user_id = i.winner_id "
-            "WHERE i.end_time>NOW() "
-            "AND EXISTS(SELECT 1 FROM bids bx WHERE bx.item_id=i.item_id AND bx.bidder_id=?) "
-            "ORDER BY i.end_time ASC";
-
-        MYSQL_BIND params[2]; memset(params, 0, sizeof(params));
-        params[0].buffer_type = MYSQL_TYPE_LONG; params[0].buffer = &userId; params[0].is_unsigned = 1;
-        params[1] = params[0];
-
-        bool any = runQueryAndPrint(conn, sql, params, 2,
-            [&](MYSQL_BIND* res, unsigned long*) {
-                std::string item_id(htmlEscape((char*)res[0].buffer));
-                std::string title(htmlEscape((char*)res[1].buffer));
-                std::string endsServer(htmlEscape((char*)res[2].buffer));
-                std::string epoch(htmlEscape((char*)res[3].buffer));
-                std::string leader(htmlEscape((char*)res[4].buffer));
-                std::string highest(htmlEscape((char*)res[5].buffer));
-                std::string yourmax(htmlEscape((char*)res[6].buffer));
-
-                std::cout << "<tr>\n"
-                    << "  <td title='" << title << "'><span class='name-wrap'>" << title << "</span></td>\n"
-                    << "  <td title='" << endsServer << "'>"
-                    << "    <time class='dt' data-epoch='" << epoch << "'>" << endsServer << "</time>"
-                    << "  </td>\n"
-                    << "  <td title='" << leader << "'>" << leader << "</td>\n"
-                    << "  <td title='$" << highest << "'>$" << highest << "</td>\n"
-                    << "  <td title='$" << yourmax << "'>$" << yourmax << "</td>\n"
-                    << "  <td>\n"
-                    << "    <div class='action-cell'>\n"
-                    << "      <form class='inline-form' action='bid.cgi' method='post'>\n"
-                    << "        <input type='hidden' name='item_id' value='" << item_id << "'>\n"
-                    << "        <input name='bid_amount' type='number' step='0.01' placeholder='Enter new max' required>\n"
-                    << "        <button class='btn primary' type='submit'>Increase</button>\n"
-                    << "      </form>\n"
-                    << "    </div>\n"
-                    << "  </td>\n"
-                    << "</tr>\n";
-            }, 7);
-        if (!any) std::cout << "<tr><td colspan='5'>No active bids.</td></tr>\n";
-    }
-    std::cout << "</tbody></table></section>\n";
+    printSection(ActivityQuery::kBids);
 
     // =====================================================
     // LOST 
@@ -322,37 +387,9 @@ void TransactionsPage::handleGet() {
       <h3 style="margin-top:0">Didn't Win</h3>
       <table aria-label="Auctions you didn't win">
         <thead><tr><th>Item</th><th>Winning Bid</th><th>Closed</th></tr></thead>
-        <tbody>
+        <tbody id="rows-lost">
 )";
-    {
-        const char* sql =
-            "SELECT i.title, "
-            "IFNULL(FORMAT((SELECT bid_amount FROM bids WHERE bid_id=i.winning_bid_id),2),'0.00'), "
-            "DATE_FORMAT(i.end_time,'%m/%d/%Y %h:%i %p'), "
-            "UNIX_TIMESTAMP(i.end_time) "
-            "FROM items i "
-            "WHERE i.winner_id IS NOT NULL "
-            "AND i.winner_id<>? "
-            "AND i.end_time < NOW() "
-            "AND EXISTS(SELECT 1 FROM bids b WHERE b.item_id=i.item_id AND b.bidder_id=?) "
-            "ORDER BY i.end_time DESC";
-        MYSQL_BIND params[2]; memset(params, 0, sizeof(params));
-        params[0].buffer_type = MYSQL_TYPE_LONG; params[0].buffer = &userId; params[0].is_unsigned = 1;
-        params[1] = params[0];
-
-        bool any = runQueryAndPrint(conn, sql, params, 2,
-            [&](MYSQL_BIND* res, unsigned long*) {
-                std::string title(htmlEscape((char*)res[0].buffer));
-                std::string bid(htmlEscape((char*)res[1].buffer));
-                std::string closedServer(htmlEscape((char*)res[2].buffer));
-                std::string epoch(htmlEscape((char*)res[3].buffer));
-                std::cout << "<tr><td><span class='name-wrap'>" << title
-                          << "</span></td><td>$" << bid
-                          << "</td><td><time class='dt' data-epoch='" << epoch << "'>" << closedServer << "</time></td></tr>\n";
-            }, 4);
-        if (!any) std::cout << "<tr><td colspan='3'>No lost auctions.</td></tr>\n";
-    }
-    std::cout << "</tbody></table></section>\n";
+    printSection(ActivityQuery::kLost);
 
     // ---------------------------------------------------------------------
     // JS: tab switcher + Pacific Time formatter
@@ -392,12 +429,41 @@ void TransactionsPage::handleGet() {
         year: 'numeric', month: '2-digit', day: '2-digit',
         hour: '2-digit', minute: '2-digit', hour12: true
       });
-      document.querySelectorAll('time.dt[data-epoch]').forEach(function(t){
-        var sec = Number(t.getAttribute('data-epoch'));
-        if (!isNaN(sec)) {
-          var d = new Date(sec * 1000);
-          t.textContent = fmt.format(d);
-        }
+      function formatTimes(root){
+        root.querySelectorAll('time.dt[data-epoch]').forEach(function(t){
+          var sec = Number(t.getAttribute('data-epoch'));
+          if (!isNaN(sec)) {
+            var d = new Date(sec * 1000);
+            t.textContent = fmt.format(d);
+          }
+        });
+      }
+      formatTimes(document);
+
+      // "Load more": fetch the next page of rows for one section
+      document.querySelectorAll('.tx-more').forEach(function(btn){
+        btn.addEventListener('click', function(){
+          var section = btn.dataset.section;
+          btn.disabled = true;
+          fetch('transactions.cgi?section=' + section + '&after=' + encodeURIComponent(btn.dataset.next),
+                { credentials: 'same-origin' })
+            .then(function(res){
+              if (res.status === 401) { window.location.href = 'login.cgi'; throw new Error('logged out'); }
+              if (!res.ok) throw new Error('HTTP ' + res.status);
+              var next = res.headers.get('X-Next-Cursor');
+              return res.text().then(function(html){ return { html: html, next: next }; });
+            })
+            .then(function(page){
+              var tbody = document.getElementById('rows-' + section);
+              var tmp = document.createElement('tbody');
+              tmp.innerHTML = page.html;
+              formatTimes(tmp);
+              while (tmp.firstChild) tbody.appendChild(tmp.firstChild);
+              if (page.next) { btn.dataset.next = page.next; btn.disabled = false; }
+              else { btn.remove(); }
+            })
+            .catch(function(){ btn.disabled = false; });
+        });
       });
     })();
     </script>
@@ -2,8 +2,10 @@
 #pragma once
 
 #include "core/Page.hpp"
+#include "core/ActivityQuery.hpp"
 #include "core/Database.hpp"
 #include "core/Session.hpp"
+#include <string_view>
 
 // -------------------------------------------------------------
 // TransactionsPage
@@ -14,11 +16,21 @@
 //   - Purchases
 //   - Lost auctions
 // Requires login; redirects to login page if not authenticated.
+// Each section shows its newest rows first; ?section=<id>&after=
+// <cursor> returns the next page as bare <tr> rows ("load more").
 // -------------------------------------------------------------
 class TransactionsPage : public Page {
 public:
-    TransactionsPage(Database& db, Session& session);
+    TransactionsPage(RequestContext& ctx);
+
+    // Append one <tr> of section `s` (no DB access; also used by
+    // the benchmarks with canned rows).
+    static void renderRow(std::pmr::string& out, const ActivityQuery::Section& s,
+        const ActivityQuery::Row& r, std::time_t now);
 
 protected:
     void handleGet() override;
+
+private:
+    void handleFragment(std::string_view sectionId, std::string_view afterText);
 };
@@ -0,0 +1,124 @@
+// utils/FormData.cpp
+#include "utils/FormData.hpp"
+
+// -------------------------------------------------------------
+// Hex digit value, or -1 when `c` is not a hex digit
+// -------------------------------------------------------------
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void FormData::reserve(std::size_t bytes) {
+    arena_.reserve(bytes);
+    fields_.reserve(8);
+}
+
+void FormData::clear() {
+    arena_.clear();
+    fields_.clear();
+    fieldStart_ = 0;
+    valueStart_ = kNoValue;
+    pending_ = 0;
+}
+
+// -------------------------------------------------------------
+// An incomplete escape is kept literally (e.g. "100%" -> "100%")
+// -------------------------------------------------------------
+void FormData::flushPending() {
+    if (pending_ >= 1) arena_ += '%';
+    if (pending_ == 2) arena_ += pendingHi_;
+    pending_ = 0;
+}
+
+// -------------------------------------------------------------
+// Close the current key=value pair; pairs without '=' are
+// dropped, matching the previous parser.
+// -------------------------------------------------------------
+void FormData::endField() {
+    flushPending();
+    const auto end = static_cast<std::uint32_t>(arena_.size());
+    if (valueStart_ == kNoValue) {
+        arena_.resize(fieldStart_);
+    }
+    else {
+        fields_.push_back(Field{ fieldStart_, valueStart_ - fieldStart_,
+                                 valueStart_, end - valueStart_ });
+    }
+    fieldStart_ = static_cast<std::uint32_t>(arena_.size());
+    valueStart_ = kNoValue;
+}
+
+// -------------------------------------------------------------
+// Decode one chunk: '+' -> ' ', %XX -> byte, '&' / '=' split
+// -------------------------------------------------------------
+void FormData::feed(std::string_view chunk) {
+    for (char c : chunk) {
+        if (pending_ == 1) {
+            if (hexValue(c) >= 0) { pendingHi_ = c; pending_ = 2; continue; }
+            flushPending();
+        }
+        else if (pending_ == 2) {
+            int lo = hexValue(c);
+            if (lo >= 0) {
+                arena_ += static_cast<char>(hexValue(pendingHi_) * 16 + lo);
+                pending_ = 0;
+                continue;
+            }
+            flushPending();
+        }
+
+        switch (c) {
+        case '&':
+            endField();
+            break;
+        case '=':
+            if (valueStart_ == kNoValue) valueStart_ = static_cast<std::uint32_t>(arena_.size());
+            else arena_ += c;
+            break;
+        case '%':
+            pending_ = 1;
+            break;
+        case '+':
+            arena_ += ' ';
+            break;
+        default:
+            arena_ += c;
+            break;
+        }
+    }
+}
+
+void FormData::finish() {
+    endField();
+}
+
+void FormData::parse(std::string_view raw) {
+    clear();
+    reserve(raw.size());
+    feed(raw);
+    finish();
+}
+
+// -------------------------------------------------------------
+// Lookup — scan backwards so the last duplicate wins
+// -------------------------------------------------------------
+const FormData::Field* FormData::find(std::string_view key) const noexcept {
+    for (auto it = fields_.rbegin(); it != fields_.rend(); ++it) {
+        if (std::string_view(arena_.data() + it->keyOff, it->keyLen) == key)
+            return &*it;
+    }
+    return nullptr;
+}
+
+std::string_view FormData::get(std::string_view key) const noexcept {
+    const Field* f = find(key);
+    if (!f) return {};
+    return std::string_view(arena_.data() + f->valOff, f->valLen);
+}
+
+bool FormData::contains(std::string_view key) const noexcept {
+    return find(key) != nullptr;
+}
@@ -0,0 +1,79 @@
+// utils/FormData.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =============================================================
+// FormData — Team Elevate Auctions
+// Flat key/value store for application/x-www-form-urlencoded
+// bodies. Keys and values are decoded into one contiguous arena
+// and looked up by linear scan (forms here have < 10 fields),
+// so parsing a small form performs no per-field allocation.
+// Storage comes from `mr` (the request arena when owned by Page).
+// =============================================================
+class FormData {
+public:
+    explicit FormData(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : arena_(mr), fields_(mr) {
+    }
+
+    // ---------------------------------------------------------
+    // Incremental decoder
+    // ---------------------------------------------------------
+
+    // Pre-size the arena for an expected raw body length.
+    void reserve(std::size_t bytes);
+
+    // Decode the next chunk of raw input. Chunks may split a
+    // field or a %XX escape anywhere.
+    void feed(std::string_view chunk);
+
+    // Flush the trailing field once all input has been fed.
+    void finish();
+
+    // Convenience: parse a complete buffer (e.g. QUERY_STRING).
+    void parse(std::string_view raw);
+
+    void clear();
+
+    // ---------------------------------------------------------
+    // Lookup (views stay valid until the next feed/clear)
+    // ---------------------------------------------------------
+
+    // Value for `key`, or empty when absent. Like the old map,
+    // a repeated key resolves to its last occurrence.
+    std::string_view get(std::string_view key) const noexcept;
+    std::string_view operator[](std::string_view key) const noexcept { return get(key); }
+
+    bool contains(std::string_view key) const noexcept;
+    std::size_t size() const noexcept { return fields_.size(); }
+    bool empty() const noexcept { return fields_.empty(); }
+
+private:
+    struct Field {
+        std::uint32_t keyOff;
+        std::uint32_t keyLen;
+        std::uint32_t valOff;
+        std::uint32_t valLen;
+    };
+
+    static constexpr std::uint32_t kNoValue = 0xFFFFFFFFu;
+
+    std::pmr::string arena_;
+    std::pmr::vector<Field> fields_;
+
+    // Decoder state for the field currently being read
+    std::uint32_t fieldStart_ = 0;
+    std::uint32_t valueStart_ = kNoValue;
+    int pending_ = 0;       // 0 = none, 1 = saw '%', 2 = saw '%X'
+    char pendingHi_ = 0;
+
+    const Field* find(std::string_view key) const noexcept;
+    void endField();
+    void flushPending();
+};
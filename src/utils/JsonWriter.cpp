@@ -0,0 +1,116 @@
+// utils/JsonWriter.cpp
+#include "utils/JsonWriter.hpp"
+#include <charconv>
+#include <cmath>
+#include <ostream>
+
+// -------------------------------------------------------------
+// Comma before every value except the first at its level (and
+// except a member value, whose comma went before its key)
+// -------------------------------------------------------------
+void JsonWriter::separate() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (!first_[depth_]) out_.put(',');
+    first_[depth_] = false;
+}
+
+void JsonWriter::open(char c) {
+    separate();
+    out_.put(c);
+    if (depth_ < kMaxDepth) ++depth_;
+    first_[depth_] = true;
+}
+
+void JsonWriter::close(char c) {
+    out_.put(c);
+    if (depth_ > 0) --depth_;
+}
+
+JsonWriter& JsonWriter::beginObject() { open('{'); return *this; }
+JsonWriter& JsonWriter::endObject()   { close('}'); return *this; }
+JsonWriter& JsonWriter::beginArray()  { open('['); return *this; }
+JsonWriter& JsonWriter::endArray()    { close(']'); return *this; }
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    escaped(name);
+    out_.put(':');
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::string(std::string_view s) {
+    separate();
+    escaped(s);
+    return *this;
+}
+
+JsonWriter& JsonWriter::number(long long v) {
+    separate();
+    char buf[24];
+    out_.write(buf, std::to_chars(buf, buf + sizeof(buf), v).ptr - buf);
+    return *this;
+}
+
+JsonWriter& JsonWriter::real(double v) {
+    if (!std::isfinite(v)) return null();
+    separate();
+    char buf[32];
+    out_.write(buf, std::to_chars(buf, buf + sizeof(buf), v).ptr - buf);
+    return *this;
+}
+
+JsonWriter& JsonWriter::boolean(bool v) {
+    separate();
+    out_ << (v ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::money(Money m) {
+    separate();
+    char buf[Money::kMaxChars + 2];
+    buf[0] = '"';
+    char* end = m.format(buf + 1);
+    *end++ = '"';
+    out_.write(buf, end - buf);
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    separate();
+    out_ << "null";
+    return *this;
+}
+
+// -------------------------------------------------------------
+// Quoted string: unescaped runs are written in one call
+// -------------------------------------------------------------
+void JsonWriter::escaped(std::string_view s) {
+    static const char hex[] = "0123456789abcdef";
+    out_.put('"');
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        out_.write(s.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"':  out_ << "\\\""; break;
+        case '\\': out_ << "\\\\"; break;
+        case '\n': out_ << "\\n"; break;
+        case '\r': out_ << "\\r"; break;
+        case '\t': out_ << "\\t"; break;
+        default: {
+            const char u[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+            out_.write(u, sizeof(u));
+        }
+        }
+    }
+    out_.write(s.data() + run, s.size() - run);
+    out_.put('"');
+}
@@ -0,0 +1,56 @@
+// utils/JsonWriter.hpp
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+#include "utils/Money.hpp"
+
+// =============================================================
+// JsonWriter — Team Elevate Auctions
+// Streaming JSON serializer. Values go straight to the output
+// stream as they are written: nothing is buffered or allocated,
+// commas are tracked per nesting level in a fixed array, and
+// numbers are formatted with to_chars on the stack.
+//
+//     JsonWriter w(std::cout);
+//     w.beginObject().key("id").number(7).key("title").string(t).endObject();
+//
+// Money is written as a string ("12.34") so clients never parse
+// prices through binary floating point.
+// =============================================================
+class JsonWriter {
+public:
+    static constexpr unsigned kMaxDepth = 16;
+
+    explicit JsonWriter(std::ostream& out) : out_(out) {}
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    // Object member name; the next call writes its value.
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& string(std::string_view s);
+    JsonWriter& number(long long v);
+    JsonWriter& real(double v);      // shortest round-trip form; NaN/inf as null
+    JsonWriter& boolean(bool v);
+    JsonWriter& money(Money m);
+    JsonWriter& null();
+
+private:
+    std::ostream& out_;
+    bool first_[kMaxDepth + 1] = { true };   // no member written yet at this level
+    unsigned depth_ = 0;
+    bool afterKey_ = false;
+
+    void separate();
+    void open(char c);
+    void close(char c);
+    void escaped(std::string_view s);
+};
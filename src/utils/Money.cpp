@@ -0,0 +1,82 @@
+// utils/Money.cpp
+#include "utils/Money.hpp"
+#include <charconv>
+#include <limits>
+#include <ostream>
+
+// Two-digit lookup table for the cents part
+static constexpr char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+// -------------------------------------------------------------
+// Parse "[digits][.d[d]]" into cents
+// -------------------------------------------------------------
+bool Money::parse(std::string_view text, Money& out) noexcept {
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    std::int64_t whole = 0;
+    const char* dot = p;
+    while (dot != end && isDigit(*dot)) ++dot;
+    if (dot != p) {
+        auto [ptr, ec] = std::from_chars(p, dot, whole);
+        if (ec != std::errc() || ptr != dot) return false;
+    }
+
+    std::int64_t frac = 0;
+    std::size_t fracDigits = 0;
+    if (dot != end) {
+        if (*dot != '.') return false;
+        for (const char* q = dot + 1; q != end; ++q) {
+            if (!isDigit(*q) || ++fracDigits > 2) return false;
+            frac = frac * 10 + (*q - '0');
+        }
+    }
+    if (dot == p && fracDigits == 0) return false;   // "" or "."
+    if (fracDigits == 1) frac *= 10;
+
+    constexpr std::int64_t kMaxWhole = std::numeric_limits<std::int64_t>::max() / 100 - 1;
+    if (whole > kMaxWhole) return false;
+
+    out = Money(whole * 100 + frac);
+    return true;
+}
+
+bool Money::parseCents(std::string_view text, Money& out) noexcept {
+    std::int64_t cents = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, cents);
+    if (ec != std::errc() || ptr != end) return false;
+    out = Money(cents);
+    return true;
+}
+
+// -------------------------------------------------------------
+// to_chars for the dollars, table lookup for the cents
+// -------------------------------------------------------------
+char* Money::format(char* first) const noexcept {
+    std::uint64_t mag = cents_ < 0 ? 0 - static_cast<std::uint64_t>(cents_)
+                                   : static_cast<std::uint64_t>(cents_);
+    if (cents_ < 0) *first++ = '-';
+
+    first = std::to_chars(first, first + 20, mag / 100).ptr;
+    const char* pair = kDigitPairs + 2 * (mag % 100);
+    first[0] = '.';
+    first[1] = pair[0];
+    first[2] = pair[1];
+    return first + 3;
+}
+
+std::string Money::str() const {
+    char buf[kMaxChars];
+    return std::string(buf, format(buf));
+}
+
+std::ostream& operator<<(std::ostream& os, Money m) {
+    char buf[Money::kMaxChars];
+    return os.write(buf, m.format(buf) - buf);
+}
@@ -0,0 +1,51 @@
+// utils/Money.hpp
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+// =============================================================
+// Money — Team Elevate Auctions
+// Exact currency amount stored as integer cents. Prices travel
+// between MariaDB and the pages as BIGINT cents
+// (CAST(ROUND(col*100) AS SIGNED) on the way out, ?/100 on the
+// way in) so comparisons never go through floating point.
+// =============================================================
+class Money {
+public:
+    // Longest output of format(): sign + 19 digits + '.' + 2
+    static constexpr std::size_t kMaxChars = 24;
+
+    constexpr Money() noexcept = default;
+    static constexpr Money fromCents(std::int64_t cents) noexcept { return Money(cents); }
+
+    constexpr std::int64_t cents() const noexcept { return cents_; }
+
+    // Parse user input such as "12", "12.5", "12.50" or ".99".
+    // Rejects signs, exponents, more than two decimals and
+    // anything that would overflow.
+    static bool parse(std::string_view text, Money& out) noexcept;
+
+    // Parse a BIGINT cents column delivered as text.
+    static bool parseCents(std::string_view text, Money& out) noexcept;
+
+    // Write "1234.56" at `first` (room for kMaxChars) and return
+    // one past the last character written.
+    char* format(char* first) const noexcept;
+
+    std::string str() const;
+
+    constexpr auto operator<=>(const Money&) const noexcept = default;
+
+private:
+    constexpr explicit Money(std::int64_t cents) noexcept : cents_(cents) {}
+
+    std::int64_t cents_ = 0;
+};
+
+// Streams the plain amount ("12.34") without a heap allocation.
+std::ostream& operator<<(std::ostream& os, Money m);
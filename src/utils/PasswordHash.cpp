@@ -0,0 +1,201 @@
+// utils/PasswordHash.cpp
+#include "utils/PasswordHash.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+
+static constexpr std::string_view kScheme = "pbkdf2-sha256";
+static constexpr std::size_t kSaltBytes = 16;
+static constexpr std::size_t kKeyBytes = 32;
+
+// Never go below this, however slow the host measures
+static constexpr unsigned kMinIterations = 100000;
+static constexpr unsigned kMaxIterations = 5000000;
+static constexpr unsigned kProbeIterations = 20000;
+
+// Next to the SharedSegment files: AUCTION_SHM_DIR (default
+// /dev/shm), same "auction-" prefix
+static std::string costCachePath() {
+    const char* dir = std::getenv("AUCTION_SHM_DIR");
+    std::string path = (dir && *dir) ? dir : "/dev/shm";
+    path += "/auction-pbkdf2-cost";
+    return path;
+}
+
+// -------------------------------------------------------------
+// Hex helpers
+// -------------------------------------------------------------
+static void appendHex(std::string& out, const unsigned char* p, std::size_t n) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    for (std::size_t i = 0; i < n; ++i) {
+        out += kHex[p[i] >> 4];
+        out += kHex[p[i] & 0x0F];
+    }
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Decode exactly `n` bytes of hex; false on bad length or digit
+static bool decodeHex(std::string_view hex, unsigned char* out, std::size_t n) {
+    if (hex.size() != 2 * n) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        int hi = hexValue(hex[2 * i]), lo = hexValue(hex[2 * i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        out[i] = static_cast<unsigned char>(hi << 4 | lo);
+    }
+    return true;
+}
+
+static bool derive(std::string_view password, const unsigned char* salt,
+    unsigned iterations, unsigned char* key) {
+    return PKCS5_PBKDF2_HMAC(password.data(), static_cast<int>(password.size()),
+        salt, kSaltBytes, static_cast<int>(iterations),
+        EVP_sha256(), kKeyBytes, key) == 1;
+}
+
+// -------------------------------------------------------------
+// Hash
+// -------------------------------------------------------------
+std::string hashPassword(std::string_view password, unsigned iterations) {
+    unsigned char salt[kSaltBytes];
+    unsigned char key[kKeyBytes];
+    if (RAND_bytes(salt, sizeof(salt)) != 1 || !derive(password, salt, iterations, key))
+        return "";
+
+    std::string out;
+    out.reserve(kScheme.size() + 12 + 2 * (kSaltBytes + kKeyBytes));
+    out += kScheme;
+    out += '$';
+    out += std::to_string(iterations);
+    out += '$';
+    appendHex(out, salt, sizeof(salt));
+    out += '$';
+    appendHex(out, key, sizeof(key));
+    return out;
+}
+
+std::string hashPassword(std::string_view password) {
+    return hashPassword(password, passwordHashIterations());
+}
+
+// -------------------------------------------------------------
+// Verify (PBKDF2 format or legacy unsalted SHA-256 hex)
+// -------------------------------------------------------------
+PasswordCheck verifyPassword(std::string_view password,
+    std::string_view stored,
+    unsigned iterations) {
+    if (stored.size() == 2 * SHA256_DIGEST_LENGTH) {
+        unsigned char want[SHA256_DIGEST_LENGTH];
+        unsigned char got[SHA256_DIGEST_LENGTH];
+        if (!decodeHex(stored, want, sizeof(want))) return PasswordCheck::Mismatch;
+        SHA256(reinterpret_cast<const unsigned char*>(password.data()), password.size(), got);
+        return CRYPTO_memcmp(want, got, sizeof(got)) == 0
+            ? PasswordCheck::MatchNeedsRehash : PasswordCheck::Mismatch;
+    }
+
+    // scheme$iterations$salt$hash
+    if (stored.substr(0, kScheme.size()) != kScheme || stored.size() <= kScheme.size() ||
+        stored[kScheme.size()] != '$')
+        return PasswordCheck::Mismatch;
+    std::string_view rest = stored.substr(kScheme.size() + 1);
+
+    std::size_t d1 = rest.find('$');
+    if (d1 == std::string_view::npos) return PasswordCheck::Mismatch;
+    std::size_t d2 = rest.find('$', d1 + 1);
+    if (d2 == std::string_view::npos) return PasswordCheck::Mismatch;
+
+    unsigned storedIterations = 0;
+    auto [ptr, ec] = std::from_chars(rest.data(), rest.data() + d1, storedIterations);
+    if (ec != std::errc() || ptr != rest.data() + d1 || storedIterations == 0)
+        return PasswordCheck::Mismatch;
+
+    unsigned char salt[kSaltBytes];
+    unsigned char want[kKeyBytes];
+    unsigned char got[kKeyBytes];
+    if (!decodeHex(rest.substr(d1 + 1, d2 - d1 - 1), salt, sizeof(salt)) ||
+        !decodeHex(rest.substr(d2 + 1), want, sizeof(want)) ||
+        !derive(password, salt, storedIterations, got))
+        return PasswordCheck::Mismatch;
+
+    if (CRYPTO_memcmp(want, got, sizeof(got)) != 0)
+        return PasswordCheck::Mismatch;
+    return storedIterations < iterations
+        ? PasswordCheck::MatchNeedsRehash : PasswordCheck::Match;
+}
+
+// -------------------------------------------------------------
+// Cost tuning
+// -------------------------------------------------------------
+static unsigned envUnsigned(const char* name, unsigned fallback) {
+    const char* v = std::getenv(name);
+    if (!v || !*v) return fallback;
+    unsigned out = 0;
+    const char* end = v + std::char_traits<char>::length(v);
+    auto [ptr, ec] = std::from_chars(v, end, out);
+    return (ec == std::errc() && ptr == end && out > 0) ? out : fallback;
+}
+
+static unsigned clampIterations(unsigned long long n) {
+    if (n < kMinIterations) return kMinIterations;
+    if (n > kMaxIterations) return kMaxIterations;
+    return static_cast<unsigned>(n);
+}
+
+// Time kProbeIterations rounds and scale to the target
+static unsigned measureIterations(unsigned targetMs) {
+    unsigned char salt[kSaltBytes] = {};
+    unsigned char key[kKeyBytes];
+
+    auto t0 = std::chrono::steady_clock::now();
+    derive("calibration", salt, kProbeIterations, key);
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+    if (us <= 0) us = 1;
+
+    return clampIterations(
+        static_cast<unsigned long long>(kProbeIterations) * targetMs * 1000 / us);
+}
+
+unsigned passwordHashIterations() {
+    static unsigned cached = 0;
+    if (cached) return cached;
+
+    if (unsigned pinned = envUnsigned("AUCTION_PBKDF2_ITERATIONS", 0))
+        return cached = clampIterations(pinned);
+
+    const unsigned targetMs = envUnsigned("AUCTION_HASH_TARGET_MS", 100);
+
+    // Cache file holds "<targetMs> <iterations>"
+    const std::string costCache = costCachePath();
+    if (std::FILE* f = std::fopen(costCache.c_str(), "r")) {
+        unsigned fileTarget = 0, fileIterations = 0;
+        bool ok = std::fscanf(f, "%u %u", &fileTarget, &fileIterations) == 2;
+        std::fclose(f);
+        if (ok && fileTarget == targetMs)
+            return cached = clampIterations(fileIterations);
+    }
+
+    cached = measureIterations(targetMs);
+
+    // Write-then-rename so concurrent readers never see a torn file
+    std::string tmp = costCache + "." + std::to_string(getpid());
+    if (std::FILE* f = std::fopen(tmp.c_str(), "w")) {
+        std::fprintf(f, "%u %u\n", targetMs, cached);
+        std::fclose(f);
+        if (std::rename(tmp.c_str(), costCache.c_str()) != 0)
+            std::remove(tmp.c_str());
+    }
+    return cached;
+}
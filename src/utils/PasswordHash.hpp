@@ -0,0 +1,45 @@
+// utils/PasswordHash.hpp
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// =============================================================
+// PasswordHash — Team Elevate Auctions
+// Salted PBKDF2-HMAC-SHA256 password hashes, stored as
+//
+//   pbkdf2-sha256$<iterations>$<salt hex>$<hash hex>
+//
+// The iteration count is tuned to a target latency (see
+// passwordHashIterations) and recorded in each hash, so raising
+// the cost later only affects new hashes; older ones are
+// upgraded on the next successful login. Unsalted SHA-256 hex
+// digests from before the switch still verify and are always
+// reported as needing a rehash.
+// =============================================================
+
+enum class PasswordCheck {
+    Mismatch,
+    Match,
+    MatchNeedsRehash   // correct, but stored with a legacy or weaker format
+};
+
+// Hash `password` with a fresh random salt at `iterations` rounds.
+std::string hashPassword(std::string_view password, unsigned iterations);
+
+// Same, at the tuned cost.
+std::string hashPassword(std::string_view password);
+
+// Constant-time check of `password` against a stored hash.
+// Hashes with fewer than `iterations` rounds match as
+// MatchNeedsRehash.
+PasswordCheck verifyPassword(std::string_view password,
+    std::string_view stored,
+    unsigned iterations);
+
+// Iteration count that makes one hash take about
+// AUCTION_HASH_TARGET_MS (default 100 ms) on this host.
+// AUCTION_PBKDF2_ITERATIONS pins it explicitly. Otherwise the
+// value is measured once and cached in /dev/shm so CGI processes
+// do not re-benchmark on every login.
+unsigned passwordHashIterations();
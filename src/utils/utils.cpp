@@ -3,9 +3,9 @@
 #include <sstream>
 #include <iomanip>
 #include <random>
-#include <openssl/sha.h>
 #include <cstring>
 #include <cstdlib>
+#include <charconv>
 
 // ----------------- Extract Cookie -----------------
 std::string getCookieValue(const std::string& cookies, const std::string& name) {
@@ -36,6 +36,42 @@ std::string htmlEscape(const std::string& s) {
     return out;
 }
 
+// Replacement for one character, or nullptr when it is safe as-is
+static const char* htmlEntity(char c) {
+    switch (c) {
+    case '&':  return "&amp;";
+    case '<':  return "&lt;";
+    case '>':  return "&gt;";
+    case '"':  return "&quot;";
+    case '\'': return "&#x27;";
+    default:   return nullptr;
+    }
+}
+
+void htmlEscape(std::ostream& out, std::string_view s) {
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (const char* rep = htmlEntity(s[i])) {
+            out.write(s.data() + run, static_cast<std::streamsize>(i - run));
+            out << rep;
+            run = i + 1;
+        }
+    }
+    out.write(s.data() + run, static_cast<std::streamsize>(s.size() - run));
+}
+
+void appendHtmlEscaped(std::pmr::string& out, std::string_view s) {
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (const char* rep = htmlEntity(s[i])) {
+            out.append(s.data() + run, i - run);
+            out += rep;
+            run = i + 1;
+        }
+    }
+    out.append(s.data() + run, s.size() - run);
+}
+
 // ----------------- URL Decode Helper -----------------
 std::string urlDecode(const std::string& str) {
     std::string result;
@@ -53,40 +89,36 @@ std::string urlDecode(const std::string& str) {
 }
 
 // ----------------- Parse POST Data -----------------
-std::map<std::string, std::string> parsePostData() {
-    std::map<std::string, std::string> data;
-    char* contentLength = std::getenv("CONTENT_LENGTH");
-    if (contentLength) {
-        int length = std::atoi(contentLength);
-        if (length > 0) {
-            std::string postData(length, '\0');
-            std::cin.read(&postData[0], length);
+PostStatus parsePostData(FormData& out, std::size_t maxBytes) {
+    out.clear();
+    const char* contentLength = std::getenv("CONTENT_LENGTH");
+    if (!contentLength)
+        return PostStatus::Ok;
 
-            std::stringstream ss(postData);
-            std::string pair;
-            while (std::getline(ss, pair, '&')) {
-                size_t pos = pair.find('=');
-                if (pos != std::string::npos) {
-                    std::string key = pair.substr(0, pos);
-                    std::string value = pair.substr(pos + 1);
-                    data[key] = urlDecode(value);
-                }
-            }
-        }
-    }
-    return data;
-}
+    std::size_t length = 0;
+    const char* end = contentLength + std::strlen(contentLength);
+    auto [ptr, ec] = std::from_chars(contentLength, end, length);
+    if (ec != std::errc() || length == 0)
+        return PostStatus::Ok;
+    if (length > maxBytes)
+        return PostStatus::TooLarge;
 
-// ----------------- SHA-256 Password Hash -----------------
-std::string hashPassword(const std::string& password) {
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256(reinterpret_cast<const unsigned char*>(password.c_str()),
-        password.length(), hash);
+    // Decoded output is never longer than the raw body.
+    out.reserve(length);
 
-    std::stringstream ss;
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; i++)
-        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
-    return ss.str();
+    char chunk[4096];
+    std::size_t remaining = length;
+    while (remaining > 0) {
+        std::size_t want = remaining < sizeof(chunk) ? remaining : sizeof(chunk);
+        std::cin.read(chunk, static_cast<std::streamsize>(want));
+        std::size_t got = static_cast<std::size_t>(std::cin.gcount());
+        out.feed(std::string_view(chunk, got));
+        remaining -= got;
+        if (got < want)
+            break;
+    }
+    out.finish();
+    return remaining == 0 ? PostStatus::Ok : PostStatus::Truncated;
 }
 
 // ----------------- Session Token Generator -----------------
@@ -1,9 +1,13 @@
 ﻿#ifndef UTILS_HPP
 #define UTILS_HPP
 
-#include <map>
+#include <cstddef>
+#include <iosfwd>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <mysql/mysql.h>
+#include "utils/FormData.hpp"
 
 // =============================================================
 // Utility Functions — Team Elevate Auctions
@@ -18,9 +22,17 @@
 // Example: getCookieValue("session_token=abc; theme=dark", "session_token") -> "abc"
 std::string getCookieValue(const std::string& cookies, const std::string& name);
 
-// Parse standard application/x-www-form-urlencoded POST data
-// from stdin into a key/value map.
-std::map<std::string, std::string> parsePostData();
+// Result of reading a POST body.
+enum class PostStatus {
+    Ok,         // body decoded (or there was none)
+    TooLarge,   // CONTENT_LENGTH exceeds the caller's cap; nothing read
+    Truncated   // stdin ended before CONTENT_LENGTH bytes arrived
+};
+
+// Stream standard application/x-www-form-urlencoded POST data
+// from stdin into `out`, reading fixed-size chunks and refusing
+// bodies larger than `maxBytes`.
+PostStatus parsePostData(FormData& out, std::size_t maxBytes);
 
 // Decode URL-encoded form strings (replaces %xx and '+').
 std::string urlDecode(const std::string& str);
@@ -29,9 +41,6 @@ std::string urlDecode(const std::string& str);
 // Security / Validation
 // -------------------------------------------------------------
 
-// Compute SHA-256 hash of a password (hex-encoded).
-std::string hashPassword(const std::string& password);
-
 // Generate a 32-character random hexadecimal session token.
 std::string generateSessionToken();
 
@@ -44,4 +53,9 @@ bool isValidEmail(const std::string& email);
 
 // Escape special HTML characters (&, <, >, ", ').
 std::string htmlEscape(const std::string& s);
+
+// Same escaping, written straight to `out` / appended to `out`
+// so hot render loops need no temporary string per field.
+void htmlEscape(std::ostream& out, std::string_view s);
+void appendHtmlEscaped(std::pmr::string& out, std::string_view s);
 #endif
\ No newline at end of file
@@ -0,0 +1,369 @@
+// tests/plan_test.cpp
+// -------------------------------------------------------------
+// Query plan regression tests (make plan-test PLAN_DB=scratch).
+//
+// Runs EXPLAIN on the statements the pages send, with binds
+// taken from the synthetic catalog (gen_catalog --seed 7), and
+// checks each table's access type, chosen index and row
+// estimate against tests/plans.expected:
+//
+//   ./plan_test --db NAME tests/plans.expected
+//   ./plan_test --db NAME --record > tests/plans.expected
+//
+// A table missing from the expectations fails only when it is
+// read with a full scan (type ALL); an expected table missing
+// from the plan fails too, so a dropped join or index is not
+// silently accepted. --record prints the observed plans with
+// row caps at twice the estimate (at least 10), as a starting
+// point when a query or the dataset changes on purpose.
+// -------------------------------------------------------------
+#include "core/ActiveItemsCache.hpp"
+#include "core/ActivityQuery.hpp"
+#include "core/BidPlacement.hpp"
+#include "core/Database.hpp"
+#include "core/RequestContext.hpp"
+#include "core/Session.hpp"
+#include "core/SlowQueryLog.hpp"
+#include "pages/ApiPage.hpp"
+#include "pages/BrowsePage.hpp"
+#include "pages/LoginPage.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Same --now as the make target passes to gen_catalog
+constexpr long long kNow = 1760000000;
+
+struct Config {
+    std::string db;
+    std::string expected;
+    bool record = false;
+};
+
+struct Case {
+    std::string name;
+    std::string sql;      // binds already inlined
+};
+
+struct PlanRow {
+    std::string table;
+    std::string type;
+    std::string key;      // "-" when no index is used
+    long long rows;
+};
+
+struct Expectation {
+    std::string name;
+    std::string table;
+    std::string types;    // '|'-separated
+    std::string key;      // '*' = any
+    long long maxRows;
+    bool seen = false;
+};
+
+[[noreturn]] void usage() {
+    std::cerr << "usage: plan_test --db NAME (--record | EXPECTED_FILE)\n";
+    std::exit(2);
+}
+
+Config parseArgs(int argc, char** argv) {
+    Config c;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view a = argv[i];
+        if (a == "--db" && i + 1 < argc) c.db = argv[++i];
+        else if (a == "--record") c.record = true;
+        else if (!a.empty() && a[0] != '-' && c.expected.empty()) c.expected = argv[i];
+        else usage();
+    }
+    if (c.db.empty() || (!c.record && c.expected.empty())) usage();
+    return c;
+}
+
+// -------------------------------------------------------------
+// Bind list whose buffers stay put while MYSQL_BINDs point at
+// them (deque: push_back never moves existing elements)
+// -------------------------------------------------------------
+struct Binds {
+    std::deque<long long> longs;
+    std::deque<std::string> strings;
+    std::vector<MYSQL_BIND> binds;
+
+    Binds& add(long long v) {
+        longs.push_back(v);
+        MYSQL_BIND b; std::memset(&b, 0, sizeof(b));
+        b.buffer_type = MYSQL_TYPE_LONGLONG;
+        b.buffer = &longs.back();
+        binds.push_back(b);
+        return *this;
+    }
+
+    Binds& add(std::string v) {
+        strings.push_back(std::move(v));
+        MYSQL_BIND b; std::memset(&b, 0, sizeof(b));
+        b.buffer_type = MYSQL_TYPE_STRING;
+        b.buffer = strings.back().data();
+        b.buffer_length = strings.back().size();
+        binds.push_back(b);
+        return *this;
+    }
+};
+
+std::string firstValue(MYSQL* conn, const std::string& sql) {
+    std::string out;
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) return out;
+    if (MYSQL_RES* res = mysql_store_result(conn)) {
+        MYSQL_ROW row = mysql_fetch_row(res);
+        if (row && row[0]) out = row[0];
+        mysql_free_result(res);
+    }
+    return out;
+}
+
+// -------------------------------------------------------------
+// Tabular EXPLAIN, columns looked up by name (MySQL and MariaDB
+// order them differently)
+// -------------------------------------------------------------
+bool explain(MYSQL* conn, const std::string& sql, std::vector<PlanRow>& out) {
+    out.clear();
+    const std::string q = "EXPLAIN " + sql;
+    if (mysql_real_query(conn, q.data(), q.size()) != 0) return false;
+    MYSQL_RES* res = mysql_store_result(conn);
+    if (!res) return false;
+
+    int table = -1, type = -1, key = -1, rows = -1;
+    const unsigned n = mysql_num_fields(res);
+    MYSQL_FIELD* fields = mysql_fetch_fields(res);
+    for (unsigned i = 0; i < n; ++i) {
+        std::string_view f = fields[i].name;
+        if (f == "table") table = static_cast<int>(i);
+        else if (f == "type") type = static_cast<int>(i);
+        else if (f == "key") key = static_cast<int>(i);
+        else if (f == "rows") rows = static_cast<int>(i);
+    }
+    if (table < 0 || type < 0 || key < 0 || rows < 0) {
+        mysql_free_result(res);
+        return false;
+    }
+
+    while (MYSQL_ROW row = mysql_fetch_row(res)) {
+        // Optimized-away and derived/union tables have no access path of their own
+        if (!row[table] || row[table][0] == '<') continue;
+        out.push_back({ row[table], row[type] ? row[type] : "-", row[key] ? row[key] : "-",
+                        row[rows] ? std::atoll(row[rows]) : 0 });
+    }
+    mysql_free_result(res);
+    return true;
+}
+
+bool loadExpectations(const std::string& path, std::vector<Expectation>& out) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "plan_test: cannot open " << path << "\n";
+        return false;
+    }
+    std::string line;
+    unsigned lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        Expectation e;
+        if (!(fields >> e.name >> e.table >> e.types >> e.key >> e.maxRows)) {
+            std::cerr << path << ":" << lineNo << ": expected `case table types key max_rows`\n";
+            return false;
+        }
+        out.push_back(std::move(e));
+    }
+    return true;
+}
+
+bool typeAllowed(std::string_view allowed, std::string_view type) {
+    while (!allowed.empty()) {
+        const std::size_t bar = allowed.find('|');
+        if (allowed.substr(0, bar) == type) return true;
+        if (bar == std::string_view::npos) break;
+        allowed.remove_prefix(bar + 1);
+    }
+    return false;
+}
+
+// -------------------------------------------------------------
+// Every statement under test, binds inlined
+// -------------------------------------------------------------
+struct Fixtures {
+    std::string token;
+    std::string email;
+    long long itemId = 0;
+    long long sellerId = 0;
+    long long activeUserId = 0;
+};
+
+bool loadFixtures(MYSQL* conn, Fixtures& f) {
+    f.token = firstValue(conn, "SELECT session_token FROM sessions ORDER BY session_id LIMIT 1");
+    f.email = firstValue(conn, "SELECT user_email FROM users ORDER BY user_id LIMIT 1");
+    f.itemId = std::atoll(firstValue(conn, "SELECT item_id FROM bids ORDER BY bid_id LIMIT 1").c_str());
+    f.sellerId = std::atoll(firstValue(conn, "SELECT seller_id FROM items ORDER BY item_id LIMIT 1").c_str());
+    f.activeUserId = std::atoll(firstValue(conn,
+        "SELECT user_id FROM user_item_activity GROUP BY user_id ORDER BY COUNT(*) DESC LIMIT 1").c_str());
+    return !f.token.empty() && !f.email.empty() && f.itemId > 0 && f.sellerId > 0 && f.activeUserId > 0;
+}
+
+bool addCase(MYSQL* conn, std::vector<Case>& cases, std::string name, std::string_view sql,
+    const MYSQL_BIND* binds, unsigned count) {
+    std::string inlined = SlowQueryLog::inlineParams(conn, sql, binds, count);
+    if (inlined.empty()) {
+        std::cerr << "plan_test: " << name << ": bind count does not match the statement\n";
+        return false;
+    }
+    cases.push_back({ std::move(name), std::move(inlined) });
+    return true;
+}
+
+bool addCase(MYSQL* conn, std::vector<Case>& cases, std::string name, std::string_view sql, const Binds& b) {
+    return addCase(conn, cases, std::move(name), sql, b.binds.data(), static_cast<unsigned>(b.binds.size()));
+}
+
+bool buildCases(MYSQL* conn, const Fixtures& f, std::vector<Case>& cases) {
+    bool ok = true;
+    ok &= addCase(conn, cases, "session.validate", Session::kValidateSql, Binds().add(f.token));
+    ok &= addCase(conn, cases, "item.state", RequestContext::kItemStateSql, Binds().add(kNow).add(f.itemId));
+    ok &= addCase(conn, cases, "active.items", RequestContext::kActiveItemsSql,
+        Binds().add(kNow).add(kNow).add(f.sellerId).add(f.sellerId));
+    ok &= addCase(conn, cases, "active.count", RequestContext::kActiveItemsCountSql,
+        Binds().add(kNow).add(kNow).add(f.sellerId).add(f.sellerId).add(std::string("%lamp%")));
+    ok &= addCase(conn, cases, "active.page", RequestContext::kActiveItemsPageSql,
+        Binds().add(kNow).add(kNow).add(f.sellerId).add(f.sellerId).add(std::string("%lamp%")).add(50).add(100));
+    ok &= addCase(conn, cases, "active.snapshot", ActiveItemsCache::kSnapshotSql, Binds().add(kNow));
+    ok &= addCase(conn, cases, "bid.top", BidPlacement::kTopBidSql, Binds().add(f.itemId));
+    ok &= addCase(conn, cases, "api.items", ApiPage::kItemsPageSql, Binds().add(0).add(kNow).add(51));
+    ok &= addCase(conn, cases, "login.lookup", LoginPage::kUserByEmailSql, Binds().add(f.email));
+
+    for (const char* sort : { "ending", "newest", "low", "high" }) {
+        for (bool search : { false, true }) {
+            std::pmr::string sql;
+            BrowsePage::appendListingSql(sql, search, sort);
+            Binds b;
+            b.add(kNow);
+            if (search) b.add(std::string("%lamp%")).add(std::string("%lamp%"));
+            ok &= addCase(conn, cases, std::string("browse.") + sort + (search ? ".search" : ""), sql, b);
+        }
+    }
+
+    // Each section on its own: EXPLAIN of the UNION ALL reports
+    // the same tables once per branch under identical aliases
+    for (const ActivityQuery::Section* s : ActivityQuery::kSections) {
+        std::pmr::string sql;
+        ActivityQuery::Params params;
+        ActivityQuery::appendSection(sql, params, *s, static_cast<long>(f.activeUserId),
+            static_cast<std::time_t>(kNow), nullptr, 26);
+        // Drop the parentheses meant for the UNION
+        std::string_view bare(sql);
+        bare = bare.substr(1, bare.size() - 2);
+        ok &= addCase(conn, cases, std::string("transactions.") + s->id, bare, params.binds, params.count);
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Config cfg = parseArgs(argc, argv);
+
+    try {
+        // Same server and account as the pages, the scratch database
+        DbConfig dbCfg = DbConfig::get();
+        dbCfg.database = cfg.db;
+        Database db(dbCfg);
+        MYSQL* conn = db.connection();
+
+        Fixtures fixtures;
+        if (!loadFixtures(conn, fixtures)) {
+            std::cerr << "plan_test: " << cfg.db << " has no catalog (load gen_catalog output first)\n";
+            return 1;
+        }
+
+        std::vector<Case> cases;
+        if (!buildCases(conn, fixtures, cases))
+            return 1;
+
+        std::vector<Expectation> expected;
+        if (!cfg.record && !loadExpectations(cfg.expected, expected))
+            return 1;
+
+        int failures = 0;
+        std::vector<PlanRow> plan;
+        for (const Case& c : cases) {
+            if (!explain(conn, c.sql, plan)) {
+                std::cerr << "FAIL " << c.name << ": EXPLAIN failed: " << mysql_error(conn) << "\n";
+                ++failures;
+                continue;
+            }
+
+            if (cfg.record) {
+                for (const PlanRow& r : plan) {
+                    std::printf("%-26s %-6s %-12s %-22s %lld\n", c.name.c_str(), r.table.c_str(),
+                        r.type.c_str(), r.key.c_str(), std::max(10LL, r.rows * 2));
+                }
+                continue;
+            }
+
+            for (const PlanRow& r : plan) {
+                auto e = std::find_if(expected.begin(), expected.end(), [&](const Expectation& x) {
+                    return x.name == c.name && x.table == r.table;
+                });
+                if (e == expected.end()) {
+                    if (r.type == "ALL") {
+                        std::cerr << "FAIL " << c.name << ": full scan of " << r.table
+                                  << " (" << r.rows << " rows)\n";
+                        ++failures;
+                    }
+                    continue;
+                }
+                e->seen = true;
+                if (!typeAllowed(e->types, r.type)) {
+                    std::cerr << "FAIL " << c.name << ": " << r.table << " access " << r.type
+                              << ", expected " << e->types << "\n";
+                    ++failures;
+                }
+                if (e->key != "*" && e->key != r.key) {
+                    std::cerr << "FAIL " << c.name << ": " << r.table << " uses " << r.key
+                              << ", expected " << e->key << "\n";
+                    ++failures;
+                }
+                if (r.rows > e->maxRows) {
+                    std::cerr << "FAIL " << c.name << ": " << r.table << " estimates " << r.rows
+                              << " rows, expected at most " << e->maxRows << "\n";
+                    ++failures;
+                }
+            }
+        }
+
+        if (cfg.record)
+            return failures ? 1 : 0;
+
+        for (const Expectation& e : expected) {
+            if (e.seen) continue;
+            const bool known = std::any_of(cases.begin(), cases.end(),
+                [&](const Case& c) { return c.name == e.name; });
+            std::cerr << "FAIL " << e.name << ": "
+                      << (known ? "table " + e.table + " not in plan" : std::string("no such case")) << "\n";
+            ++failures;
+        }
+
+        std::cout << cases.size() << " statements, " << failures << " failures\n";
+        return failures ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "plan_test: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,496 @@
+// tools/gen_catalog.cpp
+// -------------------------------------------------------------
+// Synthetic catalog + bid history for scale testing
+// (make gen_catalog).
+//
+// Writes users, items, bids, sessions and user_item_activity
+// with explicit ids into OUT_DIR, plus a load.sql that loads
+// them in dependency order:
+//
+//   ./gen_catalog --out /tmp/cat --users 200000 --items 1000000 --bids 5000000
+//   cd /tmp/cat && mysql --local-infile=1 scratch_db < load.sql
+//
+// --format tsv (default) writes one .tsv per table for LOAD DATA
+// LOCAL INFILE; --format sql writes multi-row INSERTs
+// (--batch rows each) into load.sql itself, for servers without
+// local_infile.
+//
+// Shape of the data:
+//  - bids per item are Zipfian (--zipf, default 1.1) over a
+//    shuffled item order, so popularity is not tied to item_id;
+//  - bid times on closed auctions crowd the end (--sniping share
+//    land in the last hour, exponentially closer to end_time),
+//    the rest spread over the auction; bids on open auctions
+//    spread over [start, now]; amounts rise monotonically per
+//    item;
+//  - sellers and bidders are Zipfian over users too (a few
+//    power users, a long tail);
+//  - titles run 2-12 words, descriptions log-normal up to 4000
+//    characters;
+//  - items start over [now-30d, now+2d] and run 7 days, like
+//    SellPage listings, so there are open, upcoming and closed
+//    auctions. Bids never lie after --now.
+//
+// Tables are written parents first (users, items, then bids and
+// activity). items.winning_bid_id still points forward into
+// bids, so load.sql also turns FOREIGN_KEY_CHECKS off.
+//
+// Every user's password is --password (one shared PBKDF2 hash at
+// --hash-iterations, so logins do not trigger a rehash). The
+// same --seed and --now reproduce the same rows; only the
+// password salt differs between runs.
+// -------------------------------------------------------------
+#include "utils/PasswordHash.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+struct Config {
+    std::string out = "catalog";
+    std::string format = "tsv";
+    long users = 10000;
+    long items = 100000;
+    long bids = 500000;
+    long sessions = 5000;
+    double zipf = 1.1;
+    double sniping = 0.6;
+    unsigned batch = 1000;
+    std::string password = "loadtest";
+    unsigned hashIterations = 100000;
+    std::uint64_t seed = 42;
+    std::int64_t now = 0;
+};
+
+[[noreturn]] void usage() {
+    std::cerr <<
+        "usage: gen_catalog [--out DIR] [--format tsv|sql] [--batch N]\n"
+        "                   [--users N] [--items N] [--bids N] [--sessions N]\n"
+        "                   [--zipf S] [--sniping FRACTION] [--seed N] [--now EPOCH]\n"
+        "                   [--password P] [--hash-iterations N]\n";
+    std::exit(2);
+}
+
+Config parseArgs(int argc, char** argv) {
+    Config c;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view a = argv[i];
+        if (i + 1 >= argc) usage();
+        std::string v = argv[++i];
+        if (a == "--out") c.out = v;
+        else if (a == "--format") c.format = v;
+        else if (a == "--batch") c.batch = static_cast<unsigned>(std::stoul(v));
+        else if (a == "--users") c.users = std::stol(v);
+        else if (a == "--items") c.items = std::stol(v);
+        else if (a == "--bids") c.bids = std::stol(v);
+        else if (a == "--sessions") c.sessions = std::stol(v);
+        else if (a == "--zipf") c.zipf = std::stod(v);
+        else if (a == "--sniping") c.sniping = std::stod(v);
+        else if (a == "--seed") c.seed = std::stoull(v);
+        else if (a == "--now") c.now = std::stoll(v);
+        else if (a == "--password") c.password = v;
+        else if (a == "--hash-iterations") c.hashIterations = static_cast<unsigned>(std::stoul(v));
+        else usage();
+    }
+    if ((c.format != "tsv" && c.format != "sql") || c.users < 2 || c.items < 1 ||
+        c.bids < 0 || c.sessions < 0 || c.batch == 0)
+        usage();
+    if (c.now == 0) c.now = static_cast<std::int64_t>(std::time(nullptr));
+    return c;
+}
+
+// -------------------------------------------------------------
+// Zipf(s) over [0, n) by inverse CDF lookup
+// -------------------------------------------------------------
+class Zipf {
+public:
+    Zipf(std::size_t n, double s) : cdf_(n) {
+        double sum = 0;
+        for (std::size_t k = 0; k < n; ++k) {
+            sum += 1.0 / std::pow(static_cast<double>(k + 1), s);
+            cdf_[k] = sum;
+        }
+        for (double& v : cdf_) v /= sum;
+    }
+
+    template <class Rng>
+    std::size_t operator()(Rng& rng) {
+        const double u = std::uniform_real_distribution<double>(0, 1)(rng);
+        auto it = std::lower_bound(cdf_.begin(), cdf_.end(), u);
+        return std::min<std::size_t>(static_cast<std::size_t>(it - cdf_.begin()), cdf_.size() - 1);
+    }
+
+private:
+    std::vector<double> cdf_;
+};
+
+// -------------------------------------------------------------
+// Table output: TSV for LOAD DATA, or batched INSERT tuples
+// -------------------------------------------------------------
+class Table {
+public:
+    enum Kind { Int, Text, Epoch, Null };
+
+    struct Field {
+        Kind kind;
+        std::int64_t i = 0;
+        std::string_view s;
+    };
+
+    Table(const Config& cfg, std::ostream& sql, std::string name, std::string columns)
+        : cfg_(cfg), sql_(sql), name_(std::move(name)), columns_(std::move(columns)) {
+        if (cfg_.format == "tsv")
+            tsv_.open(cfg_.out + "/" + name_ + ".tsv", std::ios::binary);
+    }
+
+    ~Table() { flush(); }
+
+    void row(std::initializer_list<Field> fields) {
+        if (cfg_.format == "tsv") {
+            bool first = true;
+            for (const Field& f : fields) {
+                if (!first) tsv_.put('\t');
+                first = false;
+                switch (f.kind) {
+                case Int: case Epoch: tsv_ << f.i; break;
+                case Null: tsv_ << "\\N"; break;
+                case Text:
+                    for (char c : f.s) {
+                        if (c == '\t') tsv_ << "\\t";
+                        else if (c == '\n') tsv_ << "\\n";
+                        else if (c == '\\') tsv_ << "\\\\";
+                        else tsv_.put(c);
+                    }
+                    break;
+                }
+            }
+            tsv_.put('\n');
+            return;
+        }
+
+        buf_ += pending_ == 0 ? "INSERT INTO " + name_ + " (" + columns_ + ") VALUES\n(" : ",\n(";
+        bool first = true;
+        for (const Field& f : fields) {
+            if (!first) buf_ += ',';
+            first = false;
+            switch (f.kind) {
+            case Int: buf_ += std::to_string(f.i); break;
+            case Epoch: buf_ += "FROM_UNIXTIME(" + std::to_string(f.i) + ")"; break;
+            case Null: buf_ += "NULL"; break;
+            case Text:
+                buf_ += '\'';
+                for (char c : f.s) {
+                    if (c == '\'' || c == '\\') buf_ += '\\';
+                    buf_ += c;
+                }
+                buf_ += '\'';
+                break;
+            }
+        }
+        buf_ += ')';
+        if (++pending_ == cfg_.batch) flush();
+    }
+
+    void flush() {
+        if (pending_ == 0) return;
+        sql_ << buf_ << ";\n";
+        buf_.clear();
+        pending_ = 0;
+    }
+
+private:
+    const Config& cfg_;
+    std::ostream& sql_;
+    std::string name_;
+    std::string columns_;
+    std::ofstream tsv_;
+    std::string buf_;
+    unsigned pending_ = 0;
+};
+
+Table::Field I(std::int64_t v) { return { Table::Int, v, {} }; }
+Table::Field T(std::string_view s) { return { Table::Text, 0, s }; }
+Table::Field E(std::int64_t epoch) { return { Table::Epoch, epoch, {} }; }
+Table::Field N() { return { Table::Null, 0, {} }; }
+
+// "12.34" from cents for DECIMAL columns
+std::string money(std::int64_t cents) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld.%02lld",
+        static_cast<long long>(cents / 100), static_cast<long long>(cents % 100));
+    return buf;
+}
+
+// LOAD DATA for one TSV; epoch columns go through FROM_UNIXTIME
+// so they land in the session time zone, like the pages' binds
+void loadStatement(std::ostream& sql, const std::string& table,
+    const std::vector<std::string>& columns, const std::vector<bool>& epoch) {
+    sql << "LOAD DATA LOCAL INFILE '" << table << ".tsv' INTO TABLE " << table << "\n  (";
+    for (std::size_t i = 0; i < columns.size(); ++i)
+        sql << (i ? ", " : "") << (epoch[i] ? "@" : "") << columns[i];
+    sql << ")";
+    bool any = false;
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (!epoch[i]) continue;
+        sql << (any ? ", " : "\n  SET ") << columns[i] << " = FROM_UNIXTIME(@" << columns[i] << ")";
+        any = true;
+    }
+    sql << ";\n";
+}
+
+const char* kWords[] = {
+    "vintage", "antique", "rare", "signed", "mint", "boxed", "handmade", "classic",
+    "camera", "lens", "guitar", "amplifier", "vinyl", "record", "watch", "clock",
+    "lamp", "chair", "table", "desk", "bicycle", "helmet", "jacket", "boots",
+    "novel", "comic", "poster", "print", "painting", "sculpture", "vase", "bowl",
+    "keyboard", "console", "cartridge", "controller", "radio", "speaker", "phone", "tablet",
+    "brass", "oak", "walnut", "leather", "silver", "gold", "ceramic", "glass",
+    "edition", "collection", "set", "pair", "lot", "bundle", "kit", "original",
+};
+
+struct Item {
+    long seller;
+    std::int64_t start, end;
+    std::int64_t startCents;
+};
+
+struct Bid {
+    std::int64_t time;
+    std::int64_t cents;
+    long bidder;
+};
+
+// -------------------------------------------------------------
+// `n` bids on one item, in time order. Seeded per item, so the
+// items pass (which needs each winner) and the bids pass draw
+// the same bids.
+// -------------------------------------------------------------
+void drawBids(const Config& cfg, std::size_t index, const Item& it, std::uint32_t n,
+    const std::vector<long>& userByRank, Zipf& userZipf, std::vector<Bid>& out) {
+    std::seed_seq seed{ cfg.seed, static_cast<std::uint64_t>(index) };
+    std::mt19937_64 rng(seed);
+    std::exponential_distribution<double> lastHour(1.0 / 600.0);   // mean 10 min before end
+    std::uniform_real_distribution<double> unit(0, 1);
+
+    // Sniping only exists once the auction has ended; an open
+    // auction's bids are spread over what has run of it so far
+    const bool closed = it.end <= cfg.now;
+    const std::int64_t until = closed ? it.end - 1 : cfg.now;
+
+    out.clear();
+    for (std::uint32_t k = 0; k < n; ++k) {
+        std::int64_t t;
+        if (closed && unit(rng) < cfg.sniping)
+            t = it.end - 1 - static_cast<std::int64_t>(lastHour(rng));
+        else
+            t = it.start + static_cast<std::int64_t>(unit(rng) * static_cast<double>(until - it.start));
+        out.push_back({ std::clamp(t, it.start, until), 0, 0 });
+    }
+    std::sort(out.begin(), out.end(), [](const Bid& a, const Bid& b) { return a.time < b.time; });
+
+    std::int64_t cents = it.startCents;
+    for (Bid& b : out) {
+        // +2..12% per bid, at least a dollar
+        cents += std::max<std::int64_t>(100, cents * (2 + static_cast<std::int64_t>(rng() % 11)) / 100);
+        long bidder;
+        do { bidder = userByRank[userZipf(rng)]; } while (bidder == it.seller);
+        b.cents = cents;
+        b.bidder = bidder;
+    }
+}
+
+std::string words(std::mt19937_64& rng, int count) {
+    std::string out;
+    for (int i = 0; i < count; ++i) {
+        if (i) out += ' ';
+        out += kWords[rng() % std::size(kWords)];
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Config cfg = parseArgs(argc, argv);
+    mkdir(cfg.out.c_str(), 0755);
+
+    std::ofstream sql(cfg.out + "/load.sql", std::ios::binary);
+    if (!sql) {
+        std::cerr << "gen_catalog: cannot write " << cfg.out << "/load.sql\n";
+        return 1;
+    }
+    sql << "-- generated by gen_catalog --seed " << cfg.seed << " --now " << cfg.now << "\n"
+        << "SET FOREIGN_KEY_CHECKS = 0;\n"
+        << "SET UNIQUE_CHECKS = 0;\n"
+        << "SET autocommit = 0;\n";
+
+    std::mt19937_64 rng(cfg.seed);
+    const std::string passwordHash = hashPassword(cfg.password, cfg.hashIterations);
+    const std::int64_t day = 86400;
+
+    // ---------------------------------------------------------
+    // users
+    // ---------------------------------------------------------
+    std::cerr << "users...\n";
+    {
+        Table t(cfg, sql, "users", "user_id, user_email, password_hash, joindate");
+        std::uniform_int_distribution<std::int64_t> joined(cfg.now - 3 * 365 * day, cfg.now - day);
+        for (long u = 1; u <= cfg.users; ++u) {
+            const std::string email = "user" + std::to_string(u) + "@example.com";
+            t.row({ I(u), T(email), T(passwordHash), E(joined(rng)) });
+        }
+    }
+
+    // Power users: Zipf rank -> shuffled user id
+    std::vector<long> userByRank(static_cast<std::size_t>(cfg.users));
+    std::iota(userByRank.begin(), userByRank.end(), 1);
+    std::shuffle(userByRank.begin(), userByRank.end(), rng);
+    Zipf userZipf(userByRank.size(), 0.9);
+
+    // ---------------------------------------------------------
+    // items (bid counts decided first so winners are known)
+    // ---------------------------------------------------------
+    std::cerr << "items...\n";
+    std::vector<Item> items(static_cast<std::size_t>(cfg.items));
+    std::uniform_int_distribution<std::int64_t> startAt(cfg.now - 30 * day, cfg.now + 2 * day);
+    std::lognormal_distribution<double> price(std::log(2500.0), 1.2);   // cents, median $25
+    for (Item& it : items) {
+        it.seller = userByRank[userZipf(rng)];
+        it.start = startAt(rng);
+        it.end = it.start + 7 * day;
+        it.startCents = std::max<std::int64_t>(100, static_cast<std::int64_t>(price(rng)));
+    }
+
+    // Only items already started can have bids
+    std::vector<std::size_t> biddable;
+    for (std::size_t i = 0; i < items.size(); ++i)
+        if (items[i].start <= cfg.now) biddable.push_back(i);
+    std::shuffle(biddable.begin(), biddable.end(), rng);
+
+    std::vector<std::uint32_t> bidCount(items.size(), 0);
+    if (!biddable.empty()) {
+        Zipf itemZipf(biddable.size(), cfg.zipf);
+        for (long b = 0; b < cfg.bids; ++b)
+            ++bidCount[biddable[itemZipf(rng)]];
+    }
+
+    // Winner = last bid of each item; bid ids run per item in order
+    struct Winner { std::int64_t bidId = 0; long bidder = 0; };
+    std::vector<Winner> winners(items.size());
+    std::vector<Bid> itemBids;
+    {
+        std::int64_t bidId = 0;
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            if (bidCount[i] == 0) continue;
+            drawBids(cfg, i, items[i], bidCount[i], userByRank, userZipf, itemBids);
+            bidId += bidCount[i];
+            winners[i] = { bidId, itemBids.back().bidder };
+        }
+    }
+
+    {
+        Table t(cfg, sql, "items",
+            "item_id, seller_id, title, description, start_price, start_time, end_time, winning_bid_id, winner_id");
+        std::uniform_int_distribution<int> titleWords(2, 12);
+        std::lognormal_distribution<double> descWords(std::log(40.0), 1.0);
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            const Item& it = items[i];
+            const std::string title = words(rng, titleWords(rng)).substr(0, 100);
+            const int dw = std::min(600, static_cast<int>(descWords(rng)));
+            const std::string desc = words(rng, dw).substr(0, 4000);
+            const std::string start = money(it.startCents);
+            const Winner& w = winners[i];
+            t.row({ I(static_cast<std::int64_t>(i + 1)), I(it.seller), T(title), T(desc), T(start),
+                    E(it.start), E(it.end),
+                    w.bidId ? I(w.bidId) : N(), w.bidId ? I(w.bidder) : N() });
+        }
+    }
+
+    // ---------------------------------------------------------
+    // bids and activity, per item
+    // ---------------------------------------------------------
+    std::cerr << "bids...\n";
+    {
+        Table bids(cfg, sql, "bids", "bid_id, item_id, bidder_id, bid_amount, bid_time");
+        Table activity(cfg, sql, "user_item_activity", "user_id, item_id, role, max_bid, end_time");
+
+        std::int64_t bidId = 0;
+        std::vector<std::pair<long, std::int64_t>> maxByBidder;        // (bidder, max cents)
+
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            const Item& it = items[i];
+            const long itemId = static_cast<long>(i + 1);
+            activity.row({ I(it.seller), I(itemId), T("seller"), N(), E(it.end) });
+
+            if (bidCount[i] == 0) continue;
+            drawBids(cfg, i, it, bidCount[i], userByRank, userZipf, itemBids);
+
+            maxByBidder.clear();
+            for (const Bid& b : itemBids) {
+                const std::string amount = money(b.cents);
+                bids.row({ I(++bidId), I(itemId), I(b.bidder), T(amount), E(b.time) });
+
+                auto m = std::find_if(maxByBidder.begin(), maxByBidder.end(),
+                    [&](const auto& p) { return p.first == b.bidder; });
+                if (m == maxByBidder.end()) maxByBidder.push_back({ b.bidder, b.cents });
+                else m->second = b.cents;
+            }
+            for (const auto& [bidder, maxCents] : maxByBidder) {
+                const std::string amount = money(maxCents);
+                activity.row({ I(bidder), I(itemId), T("bidder"), T(amount), E(it.end) });
+            }
+        }
+    }
+
+    // ---------------------------------------------------------
+    // sessions: mostly recent, a few still inside the 5 min window
+    // ---------------------------------------------------------
+    std::cerr << "sessions...\n";
+    {
+        Table t(cfg, sql, "sessions", "user_id, session_token, ip_address, last_active");
+        std::exponential_distribution<double> idle(1.0 / 1800.0);
+        char token[33];
+        for (long s = 0; s < cfg.sessions; ++s) {
+            const std::uint64_t a = rng(), b = rng();
+            std::snprintf(token, sizeof(token), "%016llx%016llx",
+                static_cast<unsigned long long>(a), static_cast<unsigned long long>(b));
+            const std::string ip = "10." + std::to_string(rng() % 256) + "." +
+                std::to_string(rng() % 256) + "." + std::to_string(rng() % 254 + 1);
+            t.row({ I(userByRank[userZipf(rng)]), T(token), T(ip),
+                    E(cfg.now - static_cast<std::int64_t>(idle(rng))) });
+        }
+    }
+
+    if (cfg.format == "tsv") {
+        loadStatement(sql, "users", { "user_id", "user_email", "password_hash", "joindate" },
+            { false, false, false, true });
+        loadStatement(sql, "items", { "item_id", "seller_id", "title", "description", "start_price",
+            "start_time", "end_time", "winning_bid_id", "winner_id" },
+            { false, false, false, false, false, true, true, false, false });
+        loadStatement(sql, "bids", { "bid_id", "item_id", "bidder_id", "bid_amount", "bid_time" },
+            { false, false, false, false, true });
+        loadStatement(sql, "sessions", { "user_id", "session_token", "ip_address", "last_active" },
+            { false, false, false, true });
+        loadStatement(sql, "user_item_activity", { "user_id", "item_id", "role", "max_bid", "end_time" },
+            { false, false, false, false, true });
+    }
+
+    sql << "COMMIT;\n"
+        << "SET UNIQUE_CHECKS = 1;\n"
+        << "SET FOREIGN_KEY_CHECKS = 1;\n"
+        << "ANALYZE TABLE users, items, bids, sessions, user_item_activity;\n";
+    std::cerr << "wrote " << cfg.out << "/load.sql\n";
+    return 0;
+}
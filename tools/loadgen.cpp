@@ -0,0 +1,468 @@
+// tools/loadgen.cpp
+// -------------------------------------------------------------
+// CGI load replay harness (make loadgen).
+//
+// Execs the built *.cgi binaries directly, the way the web
+// server would (CGI/1.1 environment + stdin body), from N
+// concurrent workers for a fixed duration, and reports per page:
+// throughput, p50/p99/p999 latency, HTTP status counts and the
+// DB statements / round trips each request made (parsed from
+// the AUCTION_REQUEST_STATS line the pages write to stderr).
+//
+//   ./loadgen --cgi-dir ~/public_html/cgi --seconds 30 --concurrency 16
+//             --mix browse=50,bid=25,transactions=15,sell=5,login=5
+//             --user alice@example.com:secret --user bob@example.com:secret
+//             --items 1-5000 > run.json
+//
+// The CGIs talk to whatever MariaDB they are built against, so
+// point them at a local scratch database (see gen_catalog).
+// Login and write limits apply as in production; raise
+// AUCTION_LOGIN_MAX_PER_EMAIL / AUCTION_BID_USER_PER_MIN etc. in
+// this process's environment to measure past them (AUCTION_*
+// variables are passed through to every CGI).
+// -------------------------------------------------------------
+#include "utils/JsonWriter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+
+// -------------------------------------------------------------
+// Configuration
+// -------------------------------------------------------------
+struct User {
+    std::string email;
+    std::string password;
+    std::string token;     // session_token after login
+};
+
+struct Config {
+    std::string cgiDir = ".";
+    unsigned seconds = 10;
+    unsigned concurrency = 4;
+    std::vector<std::pair<std::string, unsigned>> mix{ { "browse", 60 }, { "bid", 20 }, { "transactions", 20 } };
+    std::vector<User> users;
+    long itemsFrom = 1, itemsTo = 1000;
+    unsigned seed = 1;
+};
+
+const char* kPages[] = { "browse", "bid", "sell", "login", "transactions", "index" };
+
+[[noreturn]] void usage() {
+    std::cerr <<
+        "usage: loadgen [--cgi-dir DIR] [--seconds N] [--concurrency N]\n"
+        "               [--mix page=weight,...] [--user email:password]...\n"
+        "               [--items FROM-TO] [--seed N]\n"
+        "pages: browse bid sell login transactions index\n";
+    std::exit(2);
+}
+
+Config parseArgs(int argc, char** argv) {
+    Config c;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view a = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) usage();
+            return argv[++i];
+        };
+        if (a == "--cgi-dir") c.cgiDir = next();
+        else if (a == "--seconds") c.seconds = static_cast<unsigned>(std::stoul(next()));
+        else if (a == "--concurrency") c.concurrency = static_cast<unsigned>(std::stoul(next()));
+        else if (a == "--seed") c.seed = static_cast<unsigned>(std::stoul(next()));
+        else if (a == "--items") {
+            std::string v = next();
+            std::size_t dash = v.find('-');
+            if (dash == std::string::npos) usage();
+            c.itemsFrom = std::stol(v.substr(0, dash));
+            c.itemsTo = std::stol(v.substr(dash + 1));
+        }
+        else if (a == "--user") {
+            std::string v = next();
+            std::size_t colon = v.find(':');
+            if (colon == std::string::npos) usage();
+            c.users.push_back({ v.substr(0, colon), v.substr(colon + 1), "" });
+        }
+        else if (a == "--mix") {
+            c.mix.clear();
+            std::string v = next();
+            std::size_t pos = 0;
+            while (pos < v.size()) {
+                std::size_t comma = v.find(',', pos);
+                std::string item = v.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+                std::size_t eq = item.find('=');
+                if (eq == std::string::npos) usage();
+                std::string page = item.substr(0, eq);
+                if (std::find(std::begin(kPages), std::end(kPages), page) == std::end(kPages)) usage();
+                c.mix.push_back({ page, static_cast<unsigned>(std::stoul(item.substr(eq + 1))) });
+                if (comma == std::string::npos) break;
+                pos = comma + 1;
+            }
+        }
+        else usage();
+    }
+    if (c.concurrency == 0 || c.mix.empty() || c.itemsTo < c.itemsFrom) usage();
+    return c;
+}
+
+// -------------------------------------------------------------
+// One CGI execution
+// -------------------------------------------------------------
+struct Request {
+    std::string page;
+    std::string method = "GET";
+    std::string query;
+    std::string body;
+    std::string cookie;
+    std::string remoteAddr = "127.0.0.1";
+};
+
+struct Response {
+    int status = 0;               // from "Status:", 200 if absent
+    std::string headers;
+    long latencyUs = 0;
+    unsigned statements = 0, roundTrips = 0, rows = 0;
+    bool haveStats = false;
+    bool ok = false;              // child ran and exited 0
+};
+
+void parseStats(const std::string& err, Response& r) {
+    std::size_t at = err.rfind("request page=");
+    if (at == std::string::npos) return;
+    r.haveStats = std::sscanf(err.c_str() + at,
+        "request page=%*s statements=%u round_trips=%u rows=%u",
+        &r.statements, &r.roundTrips, &r.rows) == 3;
+}
+
+Response execCgi(const Config& cfg, const Request& req) {
+    Response res;
+    const std::string path = cfg.cgiDir + "/" + req.page + ".cgi";
+
+    std::vector<std::string> env{
+        "GATEWAY_INTERFACE=CGI/1.1",
+        "SERVER_PROTOCOL=HTTP/1.1",
+        "REQUEST_METHOD=" + req.method,
+        "QUERY_STRING=" + req.query,
+        "SCRIPT_NAME=/" + req.page + ".cgi",
+        "REMOTE_ADDR=" + req.remoteAddr,
+        "AUCTION_REQUEST_STATS=1",
+    };
+    if (!req.cookie.empty()) env.push_back("HTTP_COOKIE=" + req.cookie);
+    if (req.method == "POST") {
+        env.push_back("CONTENT_TYPE=application/x-www-form-urlencoded");
+        env.push_back("CONTENT_LENGTH=" + std::to_string(req.body.size()));
+    }
+    for (char** e = environ; *e; ++e) {
+        std::string_view kv = *e;
+        if (kv.substr(0, 8) == "AUCTION_" || kv.substr(0, 5) == "PATH=" ||
+            kv.substr(0, 5) == "HOME=" || kv.substr(0, 3) == "TZ=")
+            env.emplace_back(kv);
+    }
+    std::vector<char*> envp;
+    for (auto& s : env) envp.push_back(s.data());
+    envp.push_back(nullptr);
+
+    int in[2], out[2], err[2];
+    if (pipe2(in, O_CLOEXEC) || pipe2(out, O_CLOEXEC) || pipe2(err, O_CLOEXEC))
+        return res;
+
+    posix_spawn_file_actions_t fa;
+    posix_spawn_file_actions_init(&fa);
+    posix_spawn_file_actions_adddup2(&fa, in[0], 0);
+    posix_spawn_file_actions_adddup2(&fa, out[1], 1);
+    posix_spawn_file_actions_adddup2(&fa, err[1], 2);
+
+    char* argv[] = { const_cast<char*>(path.c_str()), nullptr };
+    const auto start = std::chrono::steady_clock::now();
+    pid_t pid = -1;
+    const int rc = posix_spawn(&pid, path.c_str(), &fa, nullptr, argv, envp.data());
+    posix_spawn_file_actions_destroy(&fa);
+    close(in[0]); close(out[1]); close(err[1]);
+    if (rc != 0) {
+        close(in[1]); close(out[0]); close(err[0]);
+        return res;
+    }
+
+    // Feed stdin and drain stdout/stderr together so neither side
+    // can block on a full pipe
+    std::size_t written = 0;
+    int inFd = in[1];
+    if (req.body.empty()) { close(inFd); inFd = -1; }
+    std::string stdoutHead, stderrText;
+    bool headersDone = false;
+    int open = 2;
+    char buf[16384];
+    while (open > 0 || inFd >= 0) {
+        pollfd fds[3];
+        int n = 0;
+        int outIdx = -1, errIdx = -1, inIdx = -1;
+        if (out[0] >= 0) { outIdx = n; fds[n++] = { out[0], POLLIN, 0 }; }
+        if (err[0] >= 0) { errIdx = n; fds[n++] = { err[0], POLLIN, 0 }; }
+        if (inFd >= 0)   { inIdx = n;  fds[n++] = { inFd, POLLOUT, 0 }; }
+        if (poll(fds, n, -1) < 0) break;
+
+        if (inIdx >= 0 && fds[inIdx].revents) {
+            ssize_t w = write(inFd, req.body.data() + written, req.body.size() - written);
+            if (w > 0) written += static_cast<std::size_t>(w);
+            if (w <= 0 || written == req.body.size()) { close(inFd); inFd = -1; }
+        }
+        auto drain = [&](int& fd, int idx, bool isOut) {
+            if (idx < 0 || !fds[idx].revents) return;
+            ssize_t r = read(fd, buf, sizeof(buf));
+            if (r <= 0) { close(fd); fd = -1; --open; return; }
+            if (!isOut) stderrText.append(buf, static_cast<std::size_t>(r));
+            else if (!headersDone) {
+                stdoutHead.append(buf, static_cast<std::size_t>(r));
+                // CGI allows bare LF line ends as well as CRLF
+                std::size_t end = stdoutHead.find("\r\n\r\n");
+                const std::size_t lf = stdoutHead.find("\n\n");
+                if (lf < end) end = lf;
+                if (end != std::string::npos) { stdoutHead.resize(end); headersDone = true; }
+            }
+        };
+        drain(out[0], outIdx, true);
+        drain(err[0], errIdx, false);
+    }
+
+    int wstatus = 0;
+    waitpid(pid, &wstatus, 0);
+    res.latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    res.ok = WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0;
+    res.headers = stdoutHead;
+
+    res.status = 200;
+    std::size_t st = stdoutHead.find("Status: ");
+    if (st != std::string::npos) res.status = std::atoi(stdoutHead.c_str() + st + 8);
+    parseStats(stderrText, res);
+    return res;
+}
+
+// -------------------------------------------------------------
+// Request builders
+// -------------------------------------------------------------
+const char* kWords[] = { "vintage", "lamp", "bike", "camera", "guitar", "watch", "book", "chair" };
+
+std::string formEncode(std::string_view in) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+    for (unsigned char c : in) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') out += static_cast<char>(c);
+        else { out += '%'; out += hex[c >> 4]; out += hex[c & 0xF]; }
+    }
+    return out;
+}
+
+std::string loginBody(const User& u) {
+    return "email=" + formEncode(u.email) + "&password=" + formEncode(u.password);
+}
+
+std::string cookieFor(const User* u) {
+    return u && !u->token.empty() ? "session_token=" + u->token : "";
+}
+
+Request buildRequest(const Config& cfg, const std::string& page, std::mt19937& rng,
+    const User* user, unsigned worker) {
+    Request r;
+    r.page = page;
+    r.cookie = cookieFor(user);
+    r.remoteAddr = "10.0." + std::to_string(worker / 250) + "." + std::to_string(worker % 250 + 1);
+    std::uniform_int_distribution<long> item(cfg.itemsFrom, cfg.itemsTo);
+    std::uniform_int_distribution<int> pct(0, 99);
+
+    if (page == "browse") {
+        const int p = pct(rng);
+        if (p < 20) r.query = std::string("q=") + kWords[rng() % std::size(kWords)];
+        else if (p < 35) r.query = "sort=low";
+        else if (p < 45) r.query = "sort=newest";
+    }
+    else if (page == "bid") {
+        if (pct(rng) < 40) {
+            r.query = "item_id=" + std::to_string(item(rng));      // item view
+        } else {
+            r.method = "POST";
+            r.body = "item_id=" + std::to_string(item(rng)) +
+                     "&bid_amount=" + std::to_string(1 + rng() % 5000) + "." +
+                     std::to_string(10 + rng() % 90);
+        }
+    }
+    else if (page == "sell") {
+        r.method = "POST";
+        r.body = "item_name=Loadgen+" + std::string(kWords[rng() % std::size(kWords)]) +
+                 "&description=" + std::string(50 + rng() % 400, 'x') +
+                 "&starting_price=" + std::to_string(1 + rng() % 200) + ".00" +
+                 "&start_datetime=2030-01-01T10%3A00";
+    }
+    else if (page == "login") {
+        r.method = "POST";
+        r.cookie.clear();
+        if (user)
+            r.body = loginBody(*user);
+        else
+            r.body = "email=nobody%40example.com&password=wrong";
+    }
+    return r;
+}
+
+// -------------------------------------------------------------
+// Results
+// -------------------------------------------------------------
+struct PageStats {
+    std::vector<long> latencies;
+    std::map<int, unsigned> statuses;
+    unsigned failures = 0;
+    unsigned long long statements = 0, roundTrips = 0, rows = 0, withStats = 0;
+};
+
+long percentile(std::vector<long>& v, double p) {
+    if (v.empty()) return 0;
+    std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(v.size() - 1) + 0.5);
+    return v[std::min(idx, v.size() - 1)];
+}
+
+void writeStats(JsonWriter& json, PageStats& s, double seconds) {
+    std::sort(s.latencies.begin(), s.latencies.end());
+    const double n = static_cast<double>(s.latencies.size());
+    const double withStats = static_cast<double>(s.withStats);
+    json.key("requests").number(static_cast<long long>(s.latencies.size()))
+        .key("per_second").real(seconds > 0 ? std::round(n / seconds * 100) / 100 : 0)
+        .key("p50_us").number(percentile(s.latencies, 0.50))
+        .key("p99_us").number(percentile(s.latencies, 0.99))
+        .key("p999_us").number(percentile(s.latencies, 0.999))
+        .key("max_us").number(s.latencies.empty() ? 0 : s.latencies.back())
+        .key("failures").number(s.failures);
+    auto avg = [&](unsigned long long total) {
+        return withStats > 0 ? std::round(static_cast<double>(total) / withStats * 100) / 100 : 0.0;
+    };
+    json.key("statements_per_request").real(avg(s.statements))
+        .key("round_trips_per_request").real(avg(s.roundTrips))
+        .key("rows_per_request").real(avg(s.rows));
+    json.key("status").beginObject();
+    for (const auto& [code, count] : s.statuses)
+        json.key(std::to_string(code)).number(count);
+    json.endObject();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    signal(SIGPIPE, SIG_IGN);
+    Config cfg = parseArgs(argc, argv);
+
+    // Log every user in once; workers reuse the session cookies
+    for (User& u : cfg.users) {
+        Request r;
+        r.page = "login";
+        r.method = "POST";
+        r.body = loginBody(u);
+        Response res = execCgi(cfg, r);
+        std::size_t at = res.headers.find("session_token=");
+        if (at != std::string::npos) {
+            std::size_t end = res.headers.find_first_of(";\r\n", at);
+            u.token = res.headers.substr(at + 14, end == std::string::npos ? std::string::npos : end - at - 14);
+        }
+        if (u.token.empty())
+            std::cerr << "loadgen: login failed for " << u.email << " (status " << res.status << ")\n";
+    }
+
+    unsigned totalWeight = 0;
+    for (const auto& m : cfg.mix) totalWeight += m.second;
+    if (totalWeight == 0) usage();
+
+    std::mutex mu;
+    std::map<std::string, PageStats> stats;
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::seconds(cfg.seconds);
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < cfg.concurrency; ++w) {
+        workers.emplace_back([&, w] {
+            std::mt19937 rng(cfg.seed * 7919u + w);
+            std::map<std::string, PageStats> local;
+            while (std::chrono::steady_clock::now() < deadline) {
+                unsigned pick = rng() % totalWeight;
+                const std::string* page = &cfg.mix.front().first;
+                for (const auto& m : cfg.mix) {
+                    if (pick < m.second) { page = &m.first; break; }
+                    pick -= m.second;
+                }
+                const User* user = cfg.users.empty() ? nullptr : &cfg.users[rng() % cfg.users.size()];
+                Response res = execCgi(cfg, buildRequest(cfg, *page, rng, user, w));
+
+                PageStats& s = local[*page];
+                s.latencies.push_back(res.latencyUs);
+                ++s.statuses[res.status];
+                if (!res.ok) ++s.failures;
+                if (res.haveStats) {
+                    s.statements += res.statements;
+                    s.roundTrips += res.roundTrips;
+                    s.rows += res.rows;
+                    ++s.withStats;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mu);
+            for (auto& [page, s] : local) {
+                PageStats& t = stats[page];
+                t.latencies.insert(t.latencies.end(), s.latencies.begin(), s.latencies.end());
+                for (const auto& [code, count] : s.statuses) t.statuses[code] += count;
+                t.failures += s.failures;
+                t.statements += s.statements;
+                t.roundTrips += s.roundTrips;
+                t.rows += s.rows;
+                t.withStats += s.withStats;
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    PageStats all;
+    for (auto& [page, s] : stats) {
+        all.latencies.insert(all.latencies.end(), s.latencies.begin(), s.latencies.end());
+        for (const auto& [code, count] : s.statuses) all.statuses[code] += count;
+        all.failures += s.failures;
+        all.statements += s.statements;
+        all.roundTrips += s.roundTrips;
+        all.rows += s.rows;
+        all.withStats += s.withStats;
+    }
+
+    JsonWriter json(std::cout);
+    json.beginObject()
+        .key("seconds").number(static_cast<long long>(elapsed + 0.5))
+        .key("concurrency").number(cfg.concurrency)
+        .key("seed").number(cfg.seed)
+        .key("total").beginObject();
+    writeStats(json, all, elapsed);
+    json.endObject().key("pages").beginObject();
+    for (auto& [page, s] : stats) {
+        json.key(page).beginObject();
+        writeStats(json, s, elapsed);
+        json.endObject();
+    }
+    json.endObject().endObject();
+    std::cout << "\n";
+    return 0;
+}
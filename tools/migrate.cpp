@@ -0,0 +1,333 @@
+// tools/migrate.cpp
+// -------------------------------------------------------------
+// Versioned schema migrations (make migrate).
+//
+// Applies sql/migrations/NNNN_name.sql in version order, each
+// at most once, recording it in schema_migrations (version,
+// name, checksum, applied_at, duration_ms). Then verifies the
+// indexes SchemaCheck expects and exits non-zero if any are
+// missing, so a deploy script can stop before serving traffic:
+//
+//   ./migrate                  apply pending, then verify
+//   ./migrate --status         list applied / pending / changed
+//   ./migrate --dry-run        print pending statements only
+//   ./migrate --verify         verify indexes only
+//   ./migrate --dir PATH       migrations directory
+//
+// MariaDB commits DDL implicitly, so a migration that fails
+// half way is not rolled back: every statement in a migration
+// must be safe to re-run (IF NOT EXISTS, MODIFY, INSERT IGNORE)
+// and the fixed file is simply applied again.
+//
+// ALTERs ask for ALGORITHM=INPLACE, LOCK=NONE. If the server
+// cannot honour that for a statement, it is retried without the
+// LOCK clause, then without ALGORITHM, with a warning each time.
+// A named lock (GET_LOCK) keeps two runs from interleaving.
+// -------------------------------------------------------------
+#include "core/Database.hpp"
+#include "core/SchemaCheck.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <dirent.h>
+
+namespace {
+
+// Server errors for an ALGORITHM/LOCK request it cannot meet
+constexpr unsigned kErrAlterNotSupported = 1845;
+constexpr unsigned kErrAlterNotSupportedReason = 1846;
+
+struct Config {
+    std::string dir = "sql/migrations";
+    enum { Apply, Status, DryRun, Verify } mode = Apply;
+};
+
+struct Migration {
+    unsigned version;
+    std::string file;
+    std::string text;
+    std::string checksum;
+};
+
+[[noreturn]] void usage() {
+    std::cerr << "usage: migrate [--dir PATH] [--status | --dry-run | --verify]\n";
+    std::exit(2);
+}
+
+Config parseArgs(int argc, char** argv) {
+    Config c;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view a = argv[i];
+        if (a == "--status") c.mode = Config::Status;
+        else if (a == "--dry-run") c.mode = Config::DryRun;
+        else if (a == "--verify") c.mode = Config::Verify;
+        else if (a == "--dir" && i + 1 < argc) c.dir = argv[++i];
+        else usage();
+    }
+    return c;
+}
+
+std::string checksumOf(std::string_view text) {
+    std::uint64_t h = 1469598103934665603ULL;
+    for (unsigned char ch : text) {
+        h ^= ch;
+        h *= 1099511628211ULL;
+    }
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+    return buf;
+}
+
+// NNNN_name.sql files, sorted by version; duplicates are fatal
+bool loadMigrations(const std::string& dir, std::vector<Migration>& out) {
+    DIR* d = opendir(dir.c_str());
+    if (!d) {
+        std::cerr << "migrate: cannot open " << dir << "\n";
+        return false;
+    }
+    while (dirent* e = readdir(d)) {
+        const std::string name = e->d_name;
+        std::size_t digits = 0;
+        while (digits < name.size() && std::isdigit(static_cast<unsigned char>(name[digits]))) ++digits;
+        if (digits == 0 || digits >= name.size() || name[digits] != '_' ||
+            name.size() < 4 || name.compare(name.size() - 4, 4, ".sql") != 0)
+            continue;
+
+        std::ifstream in(dir + "/" + name, std::ios::binary);
+        std::ostringstream text;
+        text << in.rdbuf();
+        Migration m{ static_cast<unsigned>(std::stoul(name.substr(0, digits))), name, text.str(), {} };
+        m.checksum = checksumOf(m.text);
+        out.push_back(std::move(m));
+    }
+    closedir(d);
+
+    std::sort(out.begin(), out.end(),
+        [](const Migration& a, const Migration& b) { return a.version < b.version; });
+    for (std::size_t i = 1; i < out.size(); ++i) {
+        if (out[i].version == out[i - 1].version) {
+            std::cerr << "migrate: " << out[i - 1].file << " and " << out[i].file
+                      << " share version " << out[i].version << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// -------------------------------------------------------------
+// Split on ';' outside quotes and comments; comment-only and
+// blank pieces are dropped
+// -------------------------------------------------------------
+std::vector<std::string> splitStatements(std::string_view text) {
+    std::vector<std::string> out;
+    std::string cur;
+    bool content = false;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c == '-' && i + 1 < text.size() && text[i + 1] == '-') {
+            while (i < text.size() && text[i] != '\n') ++i;
+            cur.push_back('\n');
+            continue;
+        }
+        if (c == '\'' || c == '"' || c == '`') {
+            std::size_t j = i + 1;
+            while (j < text.size() && text[j] != c) j += (text[j] == '\\') ? 2 : 1;
+            cur.append(text.substr(i, std::min(j + 1, text.size()) - i));
+            content = true;
+            i = j;
+            continue;
+        }
+        if (c == ';') {
+            if (content) out.push_back(cur);
+            cur.clear();
+            content = false;
+            continue;
+        }
+        if (!std::isspace(static_cast<unsigned char>(c))) content = true;
+        cur.push_back(c);
+    }
+    if (content) out.push_back(cur);
+    return out;
+}
+
+// Drop `clause` (case-insensitive, with its leading comma)
+bool removeClause(std::string& sql, std::string_view clause) {
+    std::string upper = sql;
+    for (char& ch : upper) ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    std::size_t at = upper.find(clause);
+    if (at == std::string::npos) return false;
+    std::size_t start = upper.rfind(',', at);
+    if (start == std::string::npos) start = at;
+    sql.erase(start, at + clause.size() - start);
+    return true;
+}
+
+// One statement; any result set is drained
+bool run(MYSQL* conn, const std::string& sql) {
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) return false;
+    if (MYSQL_RES* res = mysql_store_result(conn)) mysql_free_result(res);
+    return mysql_errno(conn) == 0;
+}
+
+// With the online-DDL fallback described above
+bool runMigrationStatement(MYSQL* conn, std::string sql) {
+    if (run(conn, sql)) return true;
+    for (std::string_view clause : { std::string_view("LOCK=NONE"), std::string_view("ALGORITHM=INPLACE") }) {
+        const unsigned err = mysql_errno(conn);
+        if (err != kErrAlterNotSupported && err != kErrAlterNotSupportedReason) return false;
+        std::cerr << "  warning: " << mysql_error(conn) << "\n"
+                  << "  retrying without " << clause << "\n";
+        if (!removeClause(sql, clause)) return false;
+        if (run(conn, sql)) return true;
+    }
+    return false;
+}
+
+std::string firstValue(MYSQL* conn, const std::string& sql) {
+    std::string out;
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) return out;
+    if (MYSQL_RES* res = mysql_store_result(conn)) {
+        MYSQL_ROW row = mysql_fetch_row(res);
+        if (row && row[0]) out = row[0];
+        mysql_free_result(res);
+    }
+    return out;
+}
+
+// version -> checksum of every applied migration
+bool loadApplied(MYSQL* conn, std::map<unsigned, std::string>& applied) {
+    const std::string create =
+        "CREATE TABLE IF NOT EXISTS schema_migrations ("
+        " version INT UNSIGNED NOT NULL PRIMARY KEY,"
+        " name VARCHAR(255) NOT NULL,"
+        " checksum CHAR(16) NOT NULL,"
+        " applied_at DATETIME NOT NULL,"
+        " duration_ms INT UNSIGNED NOT NULL"
+        ") ENGINE=InnoDB";
+    if (!run(conn, create)) return false;
+
+    const std::string select = "SELECT version, checksum FROM schema_migrations";
+    if (mysql_real_query(conn, select.data(), select.size()) != 0) return false;
+    MYSQL_RES* res = mysql_store_result(conn);
+    if (!res) return false;
+    while (MYSQL_ROW row = mysql_fetch_row(res)) {
+        if (row[0] && row[1]) applied[static_cast<unsigned>(std::stoul(row[0]))] = row[1];
+    }
+    mysql_free_result(res);
+    return true;
+}
+
+bool recordApplied(MYSQL* conn, const Migration& m, long long ms) {
+    std::string name(m.file.size() * 2 + 1, '\0');
+    name.resize(mysql_real_escape_string(conn, name.data(), m.file.data(), m.file.size()));
+    const std::string sql =
+        "INSERT INTO schema_migrations (version, name, checksum, applied_at, duration_ms) VALUES (" +
+        std::to_string(m.version) + ", '" + name + "', '" + m.checksum + "', NOW(), " +
+        std::to_string(ms) + ")";
+    return run(conn, sql);
+}
+
+int verify(Database& db) {
+    std::vector<std::string> missing;
+    if (!SchemaCheck::findMissing(db, missing)) {
+        std::cerr << "migrate: index check failed: " << mysql_error(db.connection()) << "\n";
+        return 1;
+    }
+    for (const std::string& m : missing)
+        std::cerr << "missing index: " << m << "\n";
+    if (!missing.empty()) return 1;
+    std::cout << "indexes ok (" << SchemaCheck::kExpectedCount << " checked)\n";
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Config cfg = parseArgs(argc, argv);
+
+    try {
+        Database db;
+        MYSQL* conn = db.connection();
+
+        if (cfg.mode == Config::Verify)
+            return verify(db);
+
+        std::vector<Migration> migrations;
+        if (!loadMigrations(cfg.dir, migrations))
+            return 1;
+
+        if (firstValue(conn, "SELECT GET_LOCK('auction_migrate', 30)") != "1") {
+            std::cerr << "migrate: another migration run holds the lock\n";
+            return 1;
+        }
+
+        std::map<unsigned, std::string> applied;
+        if (!loadApplied(conn, applied)) {
+            std::cerr << "migrate: schema_migrations: " << mysql_error(conn) << "\n";
+            return 1;
+        }
+
+        int pending = 0;
+        for (const Migration& m : migrations) {
+            auto it = applied.find(m.version);
+            if (it != applied.end()) {
+                if (it->second != m.checksum)
+                    std::cerr << "warning: " << m.file << " changed since it was applied\n";
+                if (cfg.mode == Config::Status)
+                    std::cout << "applied  " << m.file << "\n";
+                continue;
+            }
+            ++pending;
+            if (cfg.mode == Config::Status) {
+                std::cout << "pending  " << m.file << "\n";
+                continue;
+            }
+
+            const std::vector<std::string> statements = splitStatements(m.text);
+            if (cfg.mode == Config::DryRun) {
+                std::cout << "-- " << m.file << "\n";
+                for (const std::string& s : statements) std::cout << s << ";\n";
+                continue;
+            }
+
+            std::cout << "apply    " << m.file << " (" << statements.size() << " statements)\n";
+            const auto start = std::chrono::steady_clock::now();
+            for (const std::string& s : statements) {
+                if (!runMigrationStatement(conn, s)) {
+                    std::cerr << "migrate: " << m.file << " failed: " << mysql_error(conn) << "\n"
+                              << s << "\n";
+                    return 1;
+                }
+            }
+            const long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            if (!recordApplied(conn, m, ms)) {
+                std::cerr << "migrate: recording " << m.file << ": " << mysql_error(conn) << "\n";
+                return 1;
+            }
+            std::cout << "         done in " << ms << " ms\n";
+        }
+
+        if (cfg.mode != Config::Apply) {
+            if (cfg.mode == Config::Status)
+                std::cout << pending << " pending\n";
+            return 0;
+        }
+        if (pending == 0)
+            std::cout << "schema up to date\n";
+        return verify(db);
+    } catch (const std::exception& e) {
+        std::cerr << "migrate: " << e.what() << "\n";
+        return 1;
+    }
+}
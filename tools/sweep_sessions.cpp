@@ -0,0 +1,218 @@
+// tools/sweep_sessions.cpp
+// -------------------------------------------------------------
+// Expired session sweeper (make sweep_sessions).
+//
+// Session::validate ignores rows idle for longer than
+// Session::kIdleTimeoutSeconds, but only logout deletes them.
+// This walks sessions in primary-key order and deletes the
+// expired rows one small id range at a time:
+//
+//   ./sweep_sessions                   one pass, then exit (cron)
+//   ./sweep_sessions --every 300       a pass every 5 minutes
+//   ./sweep_sessions --dry-run         count expired rows only
+//
+//   --batch N      ids per DELETE (default 1000)
+//   --pause-ms N   minimum sleep between batches (default 50)
+//   --grace S      extra idle seconds before a row counts as
+//                  expired (default 60), so a request that is
+//                  validating right at the cutoff keeps its row
+//   --max-rows N   stop a pass after N deletions (default 0 = all)
+//
+// Each DELETE is its own autocommit transaction over a primary-
+// key range, so it holds row locks on at most --batch rows for a
+// few milliseconds and needs no extra index (an index on
+// last_active would be rewritten by every page view's refresh).
+// Ranges start at an id that exists (the next one is found by a
+// primary-key seek), so gaps left by logouts and earlier sweeps
+// cost no empty batches.
+// After each batch the sweeper sleeps at least as long as the
+// batch took, keeping its share of the server below one half of
+// one connection. The cutoff is taken from the server clock once
+// per pass, the same clock validate() compares against.
+//
+// Every pass prints what it purged, and deletions are counted in
+// Metrics (auction_sessions_purged_total).
+// -------------------------------------------------------------
+#include "core/Database.hpp"
+#include "core/Metrics.hpp"
+#include "core/Session.hpp"
+#include "core/Statement.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+struct Config {
+    unsigned long batch = 1000;
+    unsigned pauseMs = 50;
+    unsigned grace = 60;
+    unsigned long long maxRows = 0;
+    unsigned every = 0;
+    bool dryRun = false;
+};
+
+struct PassResult {
+    unsigned long long purged = 0;
+    unsigned batches = 0;
+    long long ms = 0;
+};
+
+[[noreturn]] void usage() {
+    std::cerr << "usage: sweep_sessions [--batch N] [--pause-ms N] [--grace S]\n"
+                 "                      [--max-rows N] [--every S] [--dry-run]\n";
+    std::exit(2);
+}
+
+Config parseArgs(int argc, char** argv) {
+    Config c;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view a = argv[i];
+        if (a == "--dry-run") { c.dryRun = true; continue; }
+        if (i + 1 >= argc) usage();
+        const std::string v = argv[++i];
+        try {
+            if (a == "--batch") c.batch = std::stoul(v);
+            else if (a == "--pause-ms") c.pauseMs = static_cast<unsigned>(std::stoul(v));
+            else if (a == "--grace") c.grace = static_cast<unsigned>(std::stoul(v));
+            else if (a == "--max-rows") c.maxRows = std::stoull(v);
+            else if (a == "--every") c.every = static_cast<unsigned>(std::stoul(v));
+            else usage();
+        } catch (const std::exception&) {
+            usage();
+        }
+    }
+    if (c.batch == 0) usage();
+    return c;
+}
+
+// One row of BIGINT columns; false when the query failed
+bool selectLongs(Database& db, const char* sql, long long* out, unsigned n, MYSQL_BIND* params = nullptr) {
+    MYSQL_BIND r[3];
+    my_bool isNull[3] = {};
+    std::memset(r, 0, sizeof(r));
+    for (unsigned i = 0; i < n; ++i) {
+        out[i] = 0;
+        r[i].buffer_type = MYSQL_TYPE_LONGLONG;
+        r[i].buffer = &out[i];
+        r[i].is_null = &isNull[i];
+    }
+    Statement stmt(db, sql);
+    if (params && !stmt.bindParams(params)) return false;
+    if (!stmt.execute() || !stmt.bindResult(r)) return false;
+    stmt.fetch();
+    return true;
+}
+
+// -------------------------------------------------------------
+// One pass from the lowest session_id to the highest that
+// existed when the pass started
+// -------------------------------------------------------------
+bool sweep(Database& db, const Config& cfg, PassResult& res) {
+    const auto passStart = std::chrono::steady_clock::now();
+
+    long long now = 0;
+    long long range[2];
+    if (!selectLongs(db, "SELECT UNIX_TIMESTAMP()", &now, 1) ||
+        !selectLongs(db, "SELECT IFNULL(MIN(session_id), 0), IFNULL(MAX(session_id), 0) FROM sessions", range, 2))
+        return false;
+    long long cutoff = now - Session::kIdleTimeoutSeconds - cfg.grace;
+
+    if (cfg.dryRun) {
+        MYSQL_BIND p[1]; std::memset(p, 0, sizeof(p));
+        p[0].buffer_type = MYSQL_TYPE_LONGLONG; p[0].buffer = &cutoff;
+        long long expired = 0;
+        if (!selectLongs(db, "SELECT COUNT(*) FROM sessions WHERE last_active < FROM_UNIXTIME(?)", &expired, 1, p))
+            return false;
+        res.purged = static_cast<unsigned long long>(expired);
+        return true;
+    }
+
+    const char* sql =
+        "DELETE FROM sessions "
+        "WHERE session_id >= ? AND session_id < ? "
+        "AND last_active < FROM_UNIXTIME(?)";
+
+    for (long long lo = range[0]; range[1] > 0 && lo <= range[1]; ) {
+        if (cfg.maxRows && res.purged >= cfg.maxRows) break;
+
+        // Never delete more than --max-rows: shrink the last range
+        long long width = static_cast<long long>(cfg.batch);
+        if (cfg.maxRows) width = std::min<long long>(width, static_cast<long long>(cfg.maxRows - res.purged));
+        long long hi = lo + width;
+
+        MYSQL_BIND p[3]; std::memset(p, 0, sizeof(p));
+        p[0].buffer_type = MYSQL_TYPE_LONGLONG; p[0].buffer = &lo;
+        p[1].buffer_type = MYSQL_TYPE_LONGLONG; p[1].buffer = &hi;
+        p[2].buffer_type = MYSQL_TYPE_LONGLONG; p[2].buffer = &cutoff;
+
+        const auto batchStart = std::chrono::steady_clock::now();
+        unsigned long long deleted = 0;
+        {
+            Statement stmt(db, sql);
+            if (!stmt.bindParams(p) || !stmt.execute()) {
+                std::cerr << "sweep_sessions: " << stmt.error() << "\n";
+                return false;
+            }
+            deleted = stmt.affectedRows();
+        }
+        const auto took = std::chrono::steady_clock::now() - batchStart;
+
+        res.purged += deleted;
+        ++res.batches;
+        if (deleted) Metrics::add(Metrics::SessionsPurged, deleted);
+
+        // Skip straight past any gap to the next existing id
+        MYSQL_BIND np[1]; std::memset(np, 0, sizeof(np));
+        np[0].buffer_type = MYSQL_TYPE_LONGLONG; np[0].buffer = &hi;
+        long long nextId = 0;
+        if (!selectLongs(db, "SELECT IFNULL(MIN(session_id), 0) FROM sessions WHERE session_id >= ?", &nextId, 1, np))
+            return false;
+        lo = nextId > 0 ? nextId : range[1] + 1;
+
+        // Throttle: rest at least as long as the batch ran
+        const auto pause = std::max<std::chrono::steady_clock::duration>(
+            std::chrono::milliseconds(cfg.pauseMs), took);
+        if (lo <= range[1]) std::this_thread::sleep_for(pause);
+    }
+
+    res.ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - passStart).count();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Config cfg = parseArgs(argc, argv);
+
+    for (;;) {
+        try {
+            Database db;
+            PassResult res;
+            if (!sweep(db, cfg, res)) {
+                std::cerr << "sweep_sessions: pass failed: " << mysql_error(db.connection()) << "\n";
+                if (!cfg.every) return 1;
+            }
+            else if (cfg.dryRun) {
+                std::cout << res.purged << " expired sessions\n";
+            }
+            else {
+                std::cout << "purged " << res.purged << " expired sessions in "
+                          << res.batches << " batches (" << res.ms << " ms)" << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "sweep_sessions: " << e.what() << "\n";
+            if (!cfg.every) return 1;
+        }
+
+        if (!cfg.every || cfg.dryRun) return 0;
+        std::this_thread::sleep_for(std::chrono::seconds(cfg.every));
+    }
+}